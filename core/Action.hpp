@@ -136,6 +136,7 @@ namespace atlas
         {
             Action d(object_ptr, name);
             d.method_ = &method_stub<ObjT, FuncT>;
+            d.threaded_method_ = &threaded_method_stub<ObjT, FuncT>;
             return d;
         }
 
@@ -159,6 +160,24 @@ namespace atlas
             Action d(object_ptr, name);
             d.addTag(tags...);
             d.method_ = &method_stub<ObjT, FuncT>;
+            d.threaded_method_ = &threaded_method_stub<ObjT, FuncT>;
+            return d;
+        }
+
+        /**
+         * \brief Create the Action that terminates a threaded sequence of Actions
+         *
+         * \return The end Action
+         *
+         * When executed threaded, every Action dispatches directly to the Action
+         * following it. The last Action of a sequence must be followed by the end
+         * Action which returns instead of dispatching.
+         */
+        static Action createThreadedEndAction()
+        {
+            Action d;
+            d.name_ = "Threaded End";
+            d.threaded_method_ = &threaded_end_stub;
             return d;
         }
 
@@ -202,6 +221,24 @@ namespace atlas
             return (*method_)(object_ptr_, state, action_it);
         }
 
+        /**
+         * \brief Execute this Action and every Action following it (direct threading)
+         * \param state AtlasState pointer
+         * \param action_it Iterator pointing to this Action
+         *
+         * \return Iterator pointing to the end Action
+         *
+         * Instead of returning to a central dispatch loop, each Action tail-calls
+         * the next Action. The sequence must be terminated with the Action created
+         * by createThreadedEndAction.
+         */
+        ItrType executeThreaded(AtlasState* state, ItrType action_it) const
+        {
+            assert(threaded_method_);
+
+            return (*threaded_method_)(object_ptr_, state, action_it);
+        }
+
         //! \brief Set the name of this Action
         void setName(const char* name) { name_ = name; }
 
@@ -262,8 +299,28 @@ namespace atlas
             return (p->*TMethod)(state, action_it);
         }
 
+        //! \brief The internal method stub for threaded execution, calls the method and then
+        //! dispatches to the next Action
+        template <class ObjT, ItrType (ObjT::*TMethod)(AtlasState*, ItrType)>
+        static ItrType threaded_method_stub(void* object_ptr, AtlasState* state, ItrType action_it)
+        {
+            ObjT* p = static_cast<ObjT*>(object_ptr);
+
+            action_it = (p->*TMethod)(state, action_it);
+
+            // Sibling call, compiles to a jump when optimizations are enabled
+            return (*action_it->threaded_method_)(action_it->object_ptr_, state, action_it);
+        }
+
+        //! \brief Threaded method stub for the end Action, stops dispatching
+        static ItrType threaded_end_stub(void*, AtlasState*, ItrType action_it)
+        {
+            return action_it;
+        }
+
         using stub_type = ItrType (*)(void*, AtlasState*, ItrType);
         stub_type method_ = nullptr;
+        stub_type threaded_method_ = nullptr;
 
         //! \brief Name of this Action
         const char* name_ = "Null Action";
@@ -1,5 +1,6 @@
 
 #include "ActionGroup.hpp"
+#include "core/AtlasState.hpp"
 
 namespace atlas
 {
@@ -7,4 +8,62 @@ namespace atlas
 
     // Not default -- defined in source file to reduce massive inlining
     ActionGroup::~ActionGroup() {}
+
+    ActionGroup* ActionGroup::execute(AtlasState* state)
+    {
+        Action::ItrType action_it = actions_.begin();
+        const Action::ItrType end_it = actions_.end();
+        state->setActionGroupEnd(end_it);
+
+        try
+        {
+            while (action_it != end_it)
+            {
+                // Actions are responsible for incrementing the Action iterator. If an Action
+                // needs to be repeated, the Action iterator will be returned without being
+                // incremented.
+                action_it = action_it->execute(state, action_it);
+            }
+        }
+        catch (ActionException & action_excp)
+        {
+            return action_excp.getActionGroup();
+        }
+
+        // An Action redirected execution by returning the end of the group
+        if (SPARTA_EXPECT_FALSE(state->hasActionGroupRedirect()))
+        {
+            return state->takeActionGroupRedirect();
+        }
+
+        return next_action_group_;
+    }
+
+    ActionGroup* ActionGroup::executeThreaded(AtlasState* state)
+    {
+        if (SPARTA_EXPECT_FALSE(threaded_actions_stale_))
+        {
+            buildThreadedActions_();
+        }
+
+        // Redirecting Actions jump to the threaded end Action
+        state->setActionGroupEnd(std::prev(threaded_actions_.end()));
+
+        try
+        {
+            Action::ItrType action_it = threaded_actions_.begin();
+            action_it->executeThreaded(state, action_it);
+        }
+        catch (ActionException & action_excp)
+        {
+            return action_excp.getActionGroup();
+        }
+
+        if (SPARTA_EXPECT_FALSE(state->hasActionGroupRedirect()))
+        {
+            return state->takeActionGroupRedirect();
+        }
+
+        return next_action_group_;
+    }
 } // namespace atlas
@@ -67,39 +67,42 @@ namespace atlas
 
         const std::vector<Action> & getActions() const { return actions_; };
 
-        ActionGroup* execute(AtlasState* state)
-        {
-            Action::ItrType action_it = actions_.begin();
-            const Action::ItrType end_it = actions_.end();
-            while (action_it != end_it)
-            {
-                try
-                {
-                    // Actions are responsible for incrementing the Action iterator. If an Action
-                    // needs to be repeated, the Action iterator will be returned without being
-                    // incremented.
-                    action_it = action_it->execute(state, action_it);
-                }
-                catch (ActionException & action_excp)
-                {
-                    return action_excp.getActionGroup();
-                }
-            }
+        //! Execute the Actions in the group and return the next ActionGroup to execute. An Action
+        //! can divert execution to a different ActionGroup (e.g. the Exception unit's) by returning
+        //! AtlasState::redirectActionGroup() or by throwing an ActionException.
+        ActionGroup* execute(AtlasState* state);
 
-            return next_action_group_;
+        //! Execute the group with direct threaded dispatch, each Action jumps straight to the
+        //! next Action instead of returning to the loop in execute()
+        ActionGroup* executeThreaded(AtlasState* state);
+
+        //! Replace all of the Actions in the group
+        void setActions(const std::vector<Action> & actions)
+        {
+            actions_ = actions;
+            threaded_actions_stale_ = true;
         }
 
         //! Add Action to the back of the group
-        void addAction(const Action & action) { actions_.emplace_back(action); }
+        void addAction(const Action & action)
+        {
+            actions_.emplace_back(action);
+            threaded_actions_stale_ = true;
+        }
 
         //! Add Action to the front of the group
-        void insertActionFront(const Action & action) { actions_.insert(actions_.begin(), action); }
+        void insertActionFront(const Action & action)
+        {
+            actions_.insert(actions_.begin(), action);
+            threaded_actions_stale_ = true;
+        }
 
         //! Insert Action before the first Action in the group with the specified Tag
         void insertActionBefore(const Action & action, const ActionTagType tag)
         {
             auto action_it = findActionWithTag_(tag);
             actions_.insert(action_it, action);
+            threaded_actions_stale_ = true;
         }
 
         //! Insert Action after the first Action in the group with the specified Tag
@@ -107,6 +110,7 @@ namespace atlas
         {
             auto action_it = findActionWithTag_(tag);
             actions_.insert(++action_it, action);
+            threaded_actions_stale_ = true;
         }
 
         //! Remove all Actions from the group with the specified Tag
@@ -117,6 +121,7 @@ namespace atlas
             sparta_assert(num_erased != 0, "Failed to remove any Actions with tag "
                                                << ActionTagFactory::getTagName(tag).c_str()
                                                << " from the ActionGroup: " << this);
+            threaded_actions_stale_ = true;
         }
 
         //! Replace an Action with the specified Tag
@@ -124,6 +129,7 @@ namespace atlas
         {
             auto action_it = findActionWithTag_(tag);
             *action_it = action;
+            threaded_actions_stale_ = true;
         }
 
         void setNextActionGroup(ActionGroup* next_action_group)
@@ -153,6 +159,18 @@ namespace atlas
 
         ActionGroup* next_action_group_ = nullptr;
 
+        // Copy of the Actions terminated with the threaded end Action, rebuilt when the group is
+        // modified
+        std::vector<Action> threaded_actions_;
+        bool threaded_actions_stale_ = true;
+
+        void buildThreadedActions_()
+        {
+            threaded_actions_ = actions_;
+            threaded_actions_.emplace_back(Action::createThreadedEndAction());
+            threaded_actions_stale_ = false;
+        }
+
         //! Find first Action in the group with the specified Tag
         Action::ItrType findActionWithTag_(const ActionTagType tag)
         {
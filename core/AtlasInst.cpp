@@ -101,6 +101,12 @@ namespace atlas
         }
     }
 
+    void AtlasInst::unlink()
+    {
+        inst_action_group_.setActions(extractor_info_->inst_action_group_.getActions());
+        link_id_ = 0;
+    }
+
     std::ostream & operator<<(std::ostream & os, const AtlasInst & inst)
     {
         os << "uid: " << std::dec << inst.uid_ << " " << inst.dasmString() << " "
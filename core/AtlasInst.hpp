@@ -57,6 +57,8 @@ namespace atlas
 
         bool isMemoryInst() const { return extractor_info_->isMemoryInst(); }
 
+        bool isChangeOfFlowInst() const { return extractor_info_->isChangeOfFlowInst(); }
+
         bool writesCsr() const;
 
         uint32_t getOpcodeSize() const { return opcode_size_; }
@@ -164,6 +166,22 @@ namespace atlas
 
         bool unimplemented() const { return unimplemented_; }
 
+        // Has Execute inserted the translate, CSR update and observer Actions into this
+        // instruction's ActionGroup since the link ID last changed?
+        bool isLinked(const uint32_t link_id) const { return link_id_ == link_id; }
+
+        void setLinked(const uint32_t link_id) { link_id_ = link_id; }
+
+        // Restore the ActionGroup built by Mavis so the instruction can be linked again
+        void unlink();
+
+        // Clear per-execution state so a cached instruction can be executed again
+        void reset()
+        {
+            translation_state_.reset();
+            unimplemented_ = false;
+        }
+
         // Translation information.  Specifically, this is for data
         // accesses
         AtlasTranslationState* getTranslationState() { return &translation_state_; }
@@ -201,6 +219,8 @@ namespace atlas
 
         ActionGroup inst_action_group_;
         bool unimplemented_ = false;
+        // Link ID of the Actions in inst_action_group_, 0 is never a valid link ID
+        uint32_t link_id_ = 0;
 
         friend std::ostream & operator<<(std::ostream & os, const AtlasInst & inst);
     };
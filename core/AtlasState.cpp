@@ -20,6 +20,11 @@
 
 #include "system/SystemCallEmulator.hpp"
 
+extern "C"
+{
+#include "source/include/softfloat.h"
+}
+
 namespace atlas
 {
     uint32_t getXlenFromIsaString_(const std::string & isa_string)
@@ -110,6 +115,7 @@ namespace atlas
     {
         auto core_tn = getContainer();
         fetch_unit_ = core_tn->getChild("fetch")->getResourceAs<Fetch*>();
+        code_page_filter_ = fetch_unit_->getCodePageFilter();
         execute_unit_ = core_tn->getChild("execute")->getResourceAs<Execute*>();
         translate_unit_ = core_tn->getChild("translate")->getResourceAs<Translate*>();
         exception_unit_ = core_tn->getChild("exception")->getResourceAs<Exception*>();
@@ -139,6 +145,10 @@ namespace atlas
 
         // Connect finish ActionGroup to Fetch
         finish_action_group_.setNextActionGroup(fetch_unit_->getActionGroup());
+        if (isFastCore())
+        {
+            inst_next_action_group_ = fetch_unit_->getActionGroup();
+        }
     }
 
     void AtlasState::onBindTreeLate_()
@@ -175,14 +185,7 @@ namespace atlas
         }
 
         // Set up translation
-        if (xlen_ == 64)
-        {
-            changeMMUMode<RV64>();
-        }
-        else
-        {
-            changeMMUMode<RV32>();
-        }
+        changeMMUMode();
 
         // FIXME: Does Sparta have a callback notif for when debug icount is reached?
         if (inst_logger_.observed())
@@ -217,6 +220,14 @@ namespace atlas
         const mavis::MatchSet<mavis::Pattern> inclusions{inclusions_};
         const std::string context_name =
             std::accumulate(inclusions_.begin(), inclusions_.end(), std::string(""));
+
+        // Called on every mstatus write, decoded instructions and basic blocks stay valid unless
+        // the set of included extensions changed
+        if (context_name == mavis_context_name_)
+        {
+            return;
+        }
+
         if (mavis_->hasContext(context_name) == false)
         {
             DLOG("Creating new Mavis context: " << context_name);
@@ -225,6 +236,12 @@ namespace atlas
         }
         DLOG("Changing Mavis context: " << context_name);
         mavis_->switchContext(context_name);
+        mavis_context_name_ = context_name;
+        ++mavis_context_id_;
+        if (fetch_unit_)
+        {
+            fetch_unit_->invalidateBlockCache();
+        }
 
         const bool compression_enabled = inclusions_.contains("c");
         if (compression_enabled)
@@ -250,18 +267,62 @@ namespace atlas
             MMUMode::SV57     // mode == 10, xlen==64
         };
 
-        const uint32_t satp_val = READ_CSR_FIELD<XLEN>(this, SATP, "mode");
+        const uint32_t satp_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SATP::mode>(this);
         sparta_assert(satp_val < satp_mmu_mode_map.size());
         const MMUMode mode = satp_mmu_mode_map[satp_val];
 
-        const uint32_t mprv_val = READ_CSR_FIELD<XLEN>(this, MSTATUS, "mprv");
-        const PrivMode prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(this, MSTATUS, "mpp");
+        const uint32_t mprv_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mprv>(this);
+        const PrivMode prev_priv_mode =
+            (PrivMode)READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpp>(this);
         ldst_priv_mode_ = (mprv_val == 1) ? prev_priv_mode : priv_mode_;
         const MMUMode ls_mode = (ldst_priv_mode_ == PrivMode::MACHINE) ? MMUMode::BAREMETAL : mode;
 
         DLOG_CODE_BLOCK(DLOG_OUTPUT("MMU Mode: " << mode);
                         DLOG_OUTPUT("MMU LS Mode: " << ls_mode););
+        translate_unit_->updateTranslationContext<XLEN>(this);
         translate_unit_->changeMMUMode<XLEN>(mode, ls_mode);
+
+        // Cached instructions have the previous mode's load/store translation Actions linked in
+        if (ls_mode != linked_ls_mmu_mode_)
+        {
+            linked_ls_mmu_mode_ = ls_mode;
+            relinkInsts_();
+        }
+
+        // Switch to the basic blocks recorded for the new translation context, the satp value
+        // is irrelevant to instruction fetch when it is not translated
+        const bool fetch_translated =
+            (priv_mode_ != PrivMode::MACHINE) && (mode != MMUMode::BAREMETAL);
+        Fetch::BlockContext block_context;
+        block_context.priv_mode = priv_mode_;
+        block_context.satp = fetch_translated ? (uint64_t)READ_CSR_REG<XLEN>(this, SATP) : 0;
+        block_context.fetch_mode = fetch_translated ? mode : MMUMode::BAREMETAL;
+        block_context.asid =
+            fetch_translated ? READ_CSR_FIELD<XLEN, CSR_FIELDS::SATP::asid>(this) : 0;
+        block_context.ls_mode = ls_mode;
+        block_context.tvm = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::tvm>(this) == 1;
+        fetch_unit_->setBlockContext(block_context);
+    }
+
+    void AtlasState::changeMMUMode()
+    {
+        if (xlen_ == 64)
+        {
+            changeMMUMode<RV64>();
+        }
+        else
+        {
+            changeMMUMode<RV32>();
+        }
+    }
+
+    void AtlasState::relinkInsts_()
+    {
+        ++link_id_;
+        if (SPARTA_EXPECT_FALSE(link_id_ == 0))
+        {
+            link_id_ = 1;
+        }
     }
 
     mavis::FileNameListType AtlasState::getUArchFiles_() const
@@ -288,8 +349,32 @@ namespace atlas
         return uarch_files;
     }
 
+    void AtlasState::setAtlasSystem(AtlasSystem* atlas_system)
+    {
+        atlas_system_ = atlas_system;
+        reservation_table_ = atlas_system->getReservationTable();
+    }
+
+    void AtlasState::snoopCodeStore_(const Addr paddr, const size_t size)
+    {
+        fetch_unit_->invalidateCodePages(paddr, size);
+    }
+
+    void AtlasState::loadSoftfloatState() const
+    {
+        softfloat_roundingMode = softfloat_rounding_mode_;
+        softfloat_exceptionFlags = softfloat_exception_flags_;
+    }
+
+    void AtlasState::saveSoftfloatState()
+    {
+        softfloat_rounding_mode_ = softfloat_roundingMode;
+        softfloat_exception_flags_ = softfloat_exceptionFlags;
+    }
+
     int64_t AtlasState::emulateSystemCall(const SystemCallStack & call_stack)
     {
+        const auto lock = atlas_system_->lockMemoryMap();
         return system_call_emulator_->emulateSystemCall(call_stack,
                                                         atlas_system_->getSystemMemory());
     }
@@ -370,18 +455,52 @@ namespace atlas
         return reg;
     }
 
-    template <typename MemoryType> MemoryType AtlasState::readMemory(const Addr paddr)
+    uint8_t* AtlasState::getHostPointer_(const Addr paddr, const size_t size)
     {
-        auto* memory = atlas_system_->getSystemMemory();
+        // Observers are notified of memory accesses by the memory map, and accesses that cross a
+        // block are split by it
+        constexpr Addr BLOCK_MASK = ~(AtlasSystem::ATLAS_SYSTEM_BLOCK_SIZE - 1);
+        const Addr block_addr = paddr & BLOCK_MASK;
+        if (SPARTA_EXPECT_FALSE((((paddr + size - 1) & BLOCK_MASK) != block_addr)
+                                || (false == isFastCore())))
+        {
+            return nullptr;
+        }
+
+        const uint32_t idx =
+            (block_addr / AtlasSystem::ATLAS_SYSTEM_BLOCK_SIZE) % HOST_BLOCK_CACHE_SIZE;
+        HostBlock & host_block = host_block_cache_[idx];
+        if (SPARTA_EXPECT_FALSE(host_block.block_addr != block_addr))
+        {
+            host_block.block_addr = block_addr;
+            host_block.host_ptr = atlas_system_->getHostBlock(block_addr);
+        }
+
+        return host_block.host_ptr ? (host_block.host_ptr + (paddr - block_addr)) : nullptr;
+    }
 
+    template <typename MemoryType> MemoryType AtlasState::readMemory(const Addr paddr)
+    {
         static_assert(std::is_trivial<MemoryType>());
         static_assert(std::is_standard_layout<MemoryType>());
         const size_t size = sizeof(MemoryType);
-        std::vector<uint8_t> buffer(sizeof(MemoryType) / sizeof(uint8_t), 0);
-        const bool success = memory->tryRead(paddr, size, buffer.data());
-        sparta_assert(success, "Failed to read from memory at address 0x" << std::hex << paddr);
 
-        const MemoryType value = convertFromByteVector<MemoryType>(buffer);
+        MemoryType value;
+        if (const uint8_t* host_ptr = getHostPointer_(paddr, size))
+        {
+            std::memcpy(&value, host_ptr, size);
+        }
+        else
+        {
+            const auto lock = atlas_system_->lockMemoryMap();
+            auto* memory = atlas_system_->getSystemMemory();
+            ByteVector buffer(sizeof(MemoryType));
+            const bool success = memory->tryRead(paddr, size, buffer.data());
+            sparta_assert(success,
+                          "Failed to read from memory at address 0x" << std::hex << paddr);
+            value = convertFromByteVector<MemoryType>(buffer);
+        }
+
         ILOG("Memory read (" << std::dec << size << "B) to 0x" << std::hex << paddr << ": 0x"
                              << (uint64_t)value);
         return value;
@@ -390,14 +509,24 @@ namespace atlas
     template <typename MemoryType>
     void AtlasState::writeMemory(const Addr paddr, const MemoryType value)
     {
-        auto* memory = atlas_system_->getSystemMemory();
-
         static_assert(std::is_trivial<MemoryType>());
         static_assert(std::is_standard_layout<MemoryType>());
         const size_t size = sizeof(MemoryType);
-        const std::vector<uint8_t> buffer = convertToByteVector<MemoryType>(value);
-        const bool success = memory->tryWrite(paddr, size, buffer.data());
-        sparta_assert(success, "Failed to write to memory at address 0x" << std::hex << paddr);
+
+        if (uint8_t* host_ptr = getHostPointer_(paddr, size))
+        {
+            std::memcpy(host_ptr, &value, size);
+        }
+        else
+        {
+            const auto lock = atlas_system_->lockMemoryMap();
+            auto* memory = atlas_system_->getSystemMemory();
+            const ByteVector buffer = convertToByteVector<MemoryType>(value);
+            const bool success = memory->tryWrite(paddr, size, buffer.data());
+            sparta_assert(success,
+                          "Failed to write to memory at address 0x" << std::hex << paddr);
+        }
+        snoopStore(paddr, size);
 
         ILOG("Memory write (" << std::dec << size << "B) to 0x" << std::hex << paddr << ": 0x"
                               << (uint64_t)value);
@@ -430,6 +559,14 @@ namespace atlas
             finish_action_group_.addAction(post_execute_action_);
             exception_unit_->getActionGroup()->insertActionBefore(pre_exception_action_,
                                                                   ActionTags::EXCEPTION_TAG);
+            inst_next_action_group_ = &finish_action_group_;
+
+            // Cached instructions need to be relinked with the observer Actions
+            relinkInsts_();
+            if (fetch_unit_)
+            {
+                fetch_unit_->invalidateBlockCache();
+            }
         }
 
         observers_.emplace_back(std::move(observer));
@@ -437,7 +574,14 @@ namespace atlas
 
     void AtlasState::insertExecuteActions(ActionGroup* action_group)
     {
-        if (pre_execute_action_)
+        if (isFastCore())
+        {
+            for (const auto & action : finish_action_group_.getActions())
+            {
+                action_group->addAction(action);
+            }
+        }
+        else
         {
             action_group->insertActionBefore(pre_execute_action_, ActionTags::EXECUTE_TAG);
         }
@@ -636,25 +780,25 @@ namespace atlas
                 POKE_CSR_REG<RV64>(this, MHARTID, hart_id_);
 
                 const uint64_t xlen_val = 2;
-                POKE_CSR_FIELD<RV64>(this, MISA, "mxl", xlen_val);
+                POKE_CSR_FIELD<RV64, CSR_FIELDS::MISA::mxl>(this, xlen_val);
 
                 const uint32_t ext_val = getMisaExtFieldValue_<RV64>();
-                POKE_CSR_FIELD<RV64>(this, MISA, "extensions", ext_val);
+                POKE_CSR_FIELD<RV64, CSR_FIELDS::MISA::extensions>(this, ext_val);
 
                 // Initialize MSTATUS/STATUS with User and Supervisor mode XLEN
-                POKE_CSR_FIELD<RV64>(this, MSTATUS, "uxl", xlen_val);
-                POKE_CSR_FIELD<RV64>(this, MSTATUS, "sxl", xlen_val);
-                POKE_CSR_FIELD<RV64>(this, SSTATUS, "uxl", xlen_val);
+                POKE_CSR_FIELD<RV64, CSR_FIELDS::MSTATUS::uxl>(this, xlen_val);
+                POKE_CSR_FIELD<RV64, CSR_FIELDS::MSTATUS::sxl>(this, xlen_val);
+                POKE_CSR_FIELD<RV64, CSR_FIELDS::SSTATUS::uxl>(this, xlen_val);
             }
             else
             {
                 POKE_CSR_REG<RV32>(this, MHARTID, hart_id_);
 
                 const uint32_t xlen_val = 1;
-                POKE_CSR_FIELD<RV32>(this, MISA, "mxl", xlen_val);
+                POKE_CSR_FIELD<RV32, CSR_FIELDS::MISA::mxl>(this, xlen_val);
 
                 const uint32_t ext_val = getMisaExtFieldValue_<RV32>();
-                POKE_CSR_FIELD<RV32>(this, MISA, "extensions", ext_val);
+                POKE_CSR_FIELD<RV32, CSR_FIELDS::MISA::extensions>(this, ext_val);
             }
 
             std::cout << "AtlasState::boot()\n";
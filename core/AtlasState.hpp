@@ -7,11 +7,13 @@
 #include "core/CoSimQuery.hpp"
 
 #include "arch/RegisterSet.hpp"
+#include "core/CodePageFilter.hpp"
 #include "include/AtlasTypes.hpp"
 #include "include/CSRBitMasks64.hpp"
 #include "include/CSRHelpers.hpp"
 
 #include "sim/AtlasAllocators.hpp"
+#include "system/ReservationTable.hpp"
 
 #include "mavis/mavis/extension_managers/RISCVExtensionManager.hpp"
 
@@ -19,6 +21,9 @@
 #include "sparta/simulation/Unit.hpp"
 #include "sparta/utils/SpartaSharedPointerAllocator.hpp"
 
+#include <array>
+#include <limits>
+
 #ifndef REG32_JSON_DIR
 #error "REG32_JSON_DIR must be defined"
 #endif
@@ -107,13 +112,43 @@ namespace atlas
             MAVIS_UID_CSRRC,
             MAVIS_UID_CSRRWI,
             MAVIS_UID_CSRRSI,
-            MAVIS_UID_CSRRCI
+            MAVIS_UID_CSRRCI,
+            MAVIS_UID_LUI,
+            MAVIS_UID_AUIPC,
+            MAVIS_UID_ADD,
+            MAVIS_UID_ADDI,
+            MAVIS_UID_ADDIW,
+            MAVIS_UID_SLLI,
+            MAVIS_UID_SRLI,
+            MAVIS_UID_JALR,
+            MAVIS_UID_LB,
+            MAVIS_UID_LBU,
+            MAVIS_UID_LH,
+            MAVIS_UID_LHU,
+            MAVIS_UID_LW,
+            MAVIS_UID_LWU,
+            MAVIS_UID_LD,
+            MAVIS_UID_ECALL,
+            MAVIS_UID_EBREAK,
+            MAVIS_UID_WFI,
+            MAVIS_UID_FENCE_I,
+            MAVIS_UID_SFENCE_VMA
         };
 
         std::set<std::string> & getMavisInclusions() { return inclusions_; }
 
         void changeMavisContext();
 
+        // Incremented whenever the Mavis context changes, used to tag decoded instructions
+        uint32_t getMavisContextId() const { return mavis_context_id_; }
+
+        // Incremented whenever the Actions Execute links into instruction ActionGroups change
+        // (load/store MMU mode or observers), decoded instructions are relinked on their next use
+        uint32_t getLinkId() const { return link_id_; }
+
+        // Load/store MMU mode of the translate Actions linked into instructions
+        MMUMode getLdstMMUMode() const { return linked_ls_mmu_mode_; }
+
         bool getStopSimOnWfi() const { return stop_sim_on_wfi_; }
 
         void setPc(Addr pc) { pc_ = pc; }
@@ -136,6 +171,7 @@ namespace atlas
 
         bool getVirtualMode() const { return virtual_mode_; }
 
+        // Call changeMMUMode afterwards, translation depends on the privilege mode
         void setPrivMode(PrivMode priv_mode, bool virt_mode)
         {
             virtual_mode_ = virt_mode && (priv_mode != PrivMode::MACHINE);
@@ -148,8 +184,37 @@ namespace atlas
 
         const Reservation & getReservation() const { return reservation_; }
 
+        // Reservation sets of all of the harts sharing memory with this hart
+        ReservationTable* getReservationTable() { return reservation_table_; }
+
+        // Must be called after every store that writes memory directly instead of through
+        // writeMemory, clears the other harts' reservations on the stored bytes and invalidates
+        // this hart's basic blocks on the stored pages
+        void snoopStore(const Addr paddr, const size_t size)
+        {
+            // The reservation table is shared through the AtlasSystem
+            if (SPARTA_EXPECT_TRUE(reservation_table_ != nullptr))
+            {
+                reservation_table_->snoopStore(hart_id_, paddr, size);
+            }
+            if (SPARTA_EXPECT_FALSE(code_page_filter_->mayContain(paddr, size)))
+            {
+                snoopCodeStore_(paddr, size);
+            }
+        }
+
+        // SoftFloat's rounding mode and exception flags are per thread, not per hart. A thread
+        // running several harts loads the hart's copy before running it and saves it afterwards.
+        void loadSoftfloatState() const;
+
+        void saveSoftfloatState();
+
+        // Must be called after satp, mstatus, menvcfg or the privilege mode change
         template <typename XLEN> void changeMMUMode();
 
+        // changeMMUMode for the current XLEN, e.g. after a DMI write to one of the registers
+        void changeMMUMode();
+
         struct SimState
         {
             uint32_t current_opcode = 0;
@@ -190,7 +255,7 @@ namespace atlas
 
         AtlasSystem* getAtlasSystem() const { return atlas_system_; }
 
-        void setAtlasSystem(AtlasSystem* atlas_system) { atlas_system_ = atlas_system; }
+        void setAtlasSystem(AtlasSystem* atlas_system);
 
         void enableInteractiveMode();
 
@@ -243,16 +308,55 @@ namespace atlas
 
         template <typename MemoryType> void writeMemory(const Addr paddr, const MemoryType value);
 
+        // Host pointer for a bulk access of size bytes at paddr. Returns nullptr if the access
+        // must go through readMemory/writeMemory (devices, accesses crossing a memory block and
+        // any access while observers are attached).
+        uint8_t* getHostMemory(const Addr paddr, const size_t size)
+        {
+            return getHostPointer_(paddr, size);
+        }
+
         void addObserver(std::unique_ptr<Observer> observer);
 
         void insertExecuteActions(ActionGroup* action_group);
 
+        // Without observers there is nothing to do between instructions other than incrementing
+        // the PC. In this "fast" core the finish Actions are linked into every instruction's
+        // ActionGroup and instructions go straight back to Fetch, the finish ActionGroup is only
+        // executed after an exception. Adding the first observer switches to the observed core.
+        bool isFastCore() const { return observers_.empty(); }
+
+        // ActionGroup to execute after an instruction's ActionGroup, Fetch for the fast core and
+        // the finish ActionGroup otherwise
+        ActionGroup* getInstNextActionGroup() const { return inst_next_action_group_; }
+
         ActionGroup* getFinishActionGroup() { return &finish_action_group_; }
 
         ActionGroup* getStopSimActionGroup() { return &stop_sim_action_group_; }
 
         Exception* getExceptionUnit() const { return exception_unit_; }
 
+        // Divert the executing ActionGroup to another ActionGroup without throwing an
+        // ActionException. Actions must return the returned iterator, which ends the executing
+        // ActionGroup.
+        Action::ItrType redirectActionGroup(ActionGroup* action_group)
+        {
+            redirect_action_group_ = action_group;
+            return action_group_end_;
+        }
+
+        // Set by the executing ActionGroup
+        void setActionGroupEnd(const Action::ItrType end_it) { action_group_end_ = end_it; }
+
+        bool hasActionGroupRedirect() const { return redirect_action_group_ != nullptr; }
+
+        ActionGroup* takeActionGroupRedirect()
+        {
+            ActionGroup* action_group = redirect_action_group_;
+            redirect_action_group_ = nullptr;
+            return action_group;
+        }
+
         void stopSim(const int64_t exit_code)
         {
             sim_state_.workload_exit_code = exit_code;
@@ -332,11 +436,34 @@ namespace atlas
         static inline mavis::InstUIDList mavis_uid_list_{
             {"csrrw", MAVIS_UID_CSRRW},   {"csrrs", MAVIS_UID_CSRRS},
             {"csrrc", MAVIS_UID_CSRRC},   {"csrrwi", MAVIS_UID_CSRRWI},
-            {"csrrsi", MAVIS_UID_CSRRSI}, {"csrrci", MAVIS_UID_CSRRCI}};
+            {"csrrsi", MAVIS_UID_CSRRSI}, {"csrrci", MAVIS_UID_CSRRCI},
+            {"lui", MAVIS_UID_LUI},       {"auipc", MAVIS_UID_AUIPC},
+            {"add", MAVIS_UID_ADD},       {"addi", MAVIS_UID_ADDI},
+            {"addiw", MAVIS_UID_ADDIW},   {"slli", MAVIS_UID_SLLI},
+            {"srli", MAVIS_UID_SRLI},     {"jalr", MAVIS_UID_JALR},
+            {"lb", MAVIS_UID_LB},         {"lbu", MAVIS_UID_LBU},
+            {"lh", MAVIS_UID_LH},         {"lhu", MAVIS_UID_LHU},
+            {"lw", MAVIS_UID_LW},         {"lwu", MAVIS_UID_LWU},
+            {"ld", MAVIS_UID_LD},         {"ecall", MAVIS_UID_ECALL},
+            {"ebreak", MAVIS_UID_EBREAK}, {"wfi", MAVIS_UID_WFI},
+            {"fence.i", MAVIS_UID_FENCE_I},
+            {"sfence.vma", MAVIS_UID_SFENCE_VMA}};
 
         // Mavis list of included extension tags
         std::set<std::string> inclusions_;
 
+        // Current Mavis context
+        std::string mavis_context_name_;
+        uint32_t mavis_context_id_ = 0;
+
+        // Current link ID for instruction ActionGroups, never 0
+        uint32_t link_id_ = 1;
+
+        // Load/store MMU mode of the translate Actions linked into instructions
+        MMUMode linked_ls_mmu_mode_ = MMUMode::INVALID;
+
+        void relinkInsts_();
+
         //! Stop simulatiion on WFI
         const bool stop_sim_on_wfi_;
 
@@ -381,6 +508,10 @@ namespace atlas
         //! LR/SC Reservations
         Reservation reservation_;
 
+        //! SoftFloat state, round to nearest even with no exceptions at reset
+        uint8_t softfloat_rounding_mode_ = 0;
+        uint8_t softfloat_exception_flags_ = 0;
+
         //! Simulation state
         SimState sim_state_;
 
@@ -396,6 +527,26 @@ namespace atlas
 
         //! AtlasSystem for accessing memory
         AtlasSystem* atlas_system_ = nullptr;
+        ReservationTable* reservation_table_ = nullptr;
+
+        // Pages with cached basic blocks, owned by Fetch
+        const CodePageFilter* code_page_filter_ = nullptr;
+
+        void snoopCodeStore_(const Addr paddr, const size_t size);
+
+        // Direct-mapped cache of host pointers to memory blocks. Accesses to ordinary memory
+        // bypass the sparta memory map, a nullptr entry means the block must go through the map.
+        struct HostBlock
+        {
+            Addr block_addr = std::numeric_limits<Addr>::max();
+            uint8_t* host_ptr = nullptr;
+        };
+
+        static constexpr uint32_t HOST_BLOCK_CACHE_SIZE = 64;
+        std::array<HostBlock, HOST_BLOCK_CACHE_SIZE> host_block_cache_;
+
+        // Returns a host pointer to paddr if the access can bypass the memory map
+        uint8_t* getHostPointer_(const Addr paddr, const size_t size);
 
         //! System Call Emulator for ecall emulation
         SystemCallEmulator* system_call_emulator_ = nullptr;
@@ -429,11 +580,16 @@ namespace atlas
 
         // Finish ActionGroup for post-execute simulator Actions
         ActionGroup finish_action_group_;
+        ActionGroup* inst_next_action_group_ = &finish_action_group_;
 
         // Stop simulation Action
         Action stop_action_;
         ActionGroup stop_sim_action_group_;
 
+        // End of the executing ActionGroup and where it is being redirected to
+        Action::ItrType action_group_end_;
+        ActionGroup* redirect_action_group_ = nullptr;
+
         // Co-simulation debug utils
         std::shared_ptr<CoSimQuery> cosim_query_;
         std::unordered_map<std::string, int> reg_ids_by_name_;
@@ -605,4 +761,37 @@ namespace atlas
             POKE_CSR_REG<XLEN>(state, reg_ident, csr_value);
         }
     }
+
+    // Field accessors using the compile-time field descriptors, e.g.
+    // READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::sum>(state)
+    template <typename XLEN, typename FIELD> static inline XLEN READ_CSR_FIELD(AtlasState* state)
+    {
+        static_assert(std::is_same_v<XLEN, RV64> || std::is_same_v<XLEN, RV32>);
+        constexpr XLEN mask = getCsrFieldMask<XLEN, FIELD>();
+        constexpr uint32_t field_lsb = getCsrFieldLowBit<XLEN, FIELD>();
+        return (state->getCsrRegister(FIELD::reg_num)->dmiRead<XLEN>() & mask)
+               >> field_lsb;
+    }
+
+    template <typename XLEN, typename FIELD>
+    static inline void WRITE_CSR_FIELD(AtlasState* state, uint64_t field_value)
+    {
+        static_assert(std::is_same_v<XLEN, RV64> || std::is_same_v<XLEN, RV32>);
+        constexpr XLEN mask = getCsrFieldMask<XLEN, FIELD>();
+        constexpr uint32_t field_lsb = getCsrFieldLowBit<XLEN, FIELD>();
+        const XLEN csr_value = READ_CSR_REG<XLEN>(state, FIELD::reg_num);
+        WRITE_CSR_REG<XLEN>(state, FIELD::reg_num,
+                            (csr_value & ~mask) | ((XLEN(field_value) << field_lsb) & mask));
+    }
+
+    template <typename XLEN, typename FIELD>
+    static inline void POKE_CSR_FIELD(AtlasState* state, uint64_t field_value)
+    {
+        static_assert(std::is_same_v<XLEN, RV64> || std::is_same_v<XLEN, RV32>);
+        constexpr XLEN mask = getCsrFieldMask<XLEN, FIELD>();
+        constexpr uint32_t field_lsb = getCsrFieldLowBit<XLEN, FIELD>();
+        const XLEN csr_value = READ_CSR_REG<XLEN>(state, FIELD::reg_num);
+        POKE_CSR_REG<XLEN>(state, FIELD::reg_num,
+                           (csr_value & ~mask) | ((XLEN(field_value) << field_lsb) & mask));
+    }
 } // namespace atlas
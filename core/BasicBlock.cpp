@@ -0,0 +1,380 @@
+#include "core/BasicBlock.hpp"
+#include "core/AtlasState.hpp"
+#include "core/inst_handlers/inst_helpers.hpp"
+
+#include <map>
+#include <type_traits>
+
+namespace atlas
+{
+    BasicBlock::BasicBlock(const Addr start_pc, const Addr start_paddr) :
+        start_pc_(start_pc),
+        start_page_(start_pc & ~(PAGE_SIZE - 1)),
+        physical_page_(start_paddr & ~(PAGE_SIZE - 1)),
+        end_pc_(start_pc),
+        action_group_("BasicBlock")
+    {
+    }
+
+    void BasicBlock::addInst(const AtlasInstPtr & inst)
+    {
+        sparta_assert(action_group_.getActions().empty(),
+                      "Cannot add an instruction to a finalized basic block");
+        insts_.emplace_back(end_pc_, inst);
+        end_pc_ += inst->getOpcodeSize();
+    }
+
+    void BasicBlock::finalize(AtlasState* state, ActionGroup* next_action_group,
+                              const bool enable_fusion)
+    {
+        sparta_assert(insts_.empty() == false, "Cannot finalize an empty basic block");
+
+        // Instructions retire with the same Actions as the finish ActionGroup (increment PC and
+        // the post-execute observer Action, if there is one). The fast core has already linked
+        // them into every instruction's ActionGroup.
+        const std::vector<Action> no_actions;
+        const std::vector<Action> & finish_actions =
+            state->isFastCore() ? no_actions : state->getFinishActionGroup()->getActions();
+
+        auto add_inst_actions = [this, &finish_actions](BlockInst & block_inst)
+        {
+            action_group_.addAction(
+                Action::createAction<&BlockInst::beginInst_>(&block_inst, "begin inst"));
+            for (const auto & action : block_inst.inst->getActionGroup()->getActions())
+            {
+                action_group_.addAction(action);
+            }
+            for (const auto & action : finish_actions)
+            {
+                action_group_.addAction(action);
+            }
+        };
+
+        // Fused instructions skip the observers, so only the fast core can fuse
+        const bool fuse = enable_fusion && state->isFastCore() && (state->getXlen() == 64);
+        fused_insts_.reserve(insts_.size() / 2);
+
+        for (size_t idx = 0; idx < insts_.size(); ++idx)
+        {
+            BlockInst & block_inst = insts_[idx];
+            if (fuse && ((idx + 1) < insts_.size()))
+            {
+                BlockInst & next_block_inst = insts_[idx + 1];
+                if (auto create_action =
+                        FusedInst::getCreateAction(state, block_inst, next_block_inst))
+                {
+                    FusedInst & fused_inst = fused_insts_.emplace_back(block_inst, next_block_inst);
+                    action_group_.addAction(create_action(&fused_inst));
+                    const size_t num_actions = action_group_.getActions().size();
+                    add_inst_actions(block_inst);
+                    add_inst_actions(next_block_inst);
+                    fused_inst.num_unfused_actions =
+                        action_group_.getActions().size() - num_actions;
+                    ++idx;
+                    continue;
+                }
+            }
+            add_inst_actions(block_inst);
+        }
+
+        action_group_.setNextActionGroup(next_action_group);
+    }
+
+    bool BasicBlock::endsBasicBlock(const AtlasInstPtr & inst)
+    {
+        // Instructions that can change the translation or decode context of the instructions
+        // that follow them also end the block, the following instructions are recorded in a
+        // block of the new context.
+        if (inst->isChangeOfFlowInst() || inst->hasCsr())
+        {
+            return true;
+        }
+
+        switch (inst->getMavisUid())
+        {
+            case AtlasState::MavisUIDs::MAVIS_UID_ECALL:
+            case AtlasState::MavisUIDs::MAVIS_UID_EBREAK:
+            case AtlasState::MavisUIDs::MAVIS_UID_WFI:
+            case AtlasState::MavisUIDs::MAVIS_UID_FENCE_I:
+            case AtlasState::MavisUIDs::MAVIS_UID_SFENCE_VMA:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    Action::ItrType BasicBlock::BlockInst::beginInst_(AtlasState* state, Action::ItrType action_it)
+    {
+        AtlasState::SimState* sim_state = state->getSimState();
+
+        // The previous instruction stopped simulation
+        if (SPARTA_EXPECT_FALSE(sim_state->sim_stopped))
+        {
+            return state->redirectActionGroup(state->getStopSimActionGroup());
+        }
+
+        sim_state->current_opcode = inst->getOpcode();
+        ++(sim_state->current_uid);
+
+        inst->reset();
+        state->setCurrentInst(inst);
+        // Set next PC, can be overidden by a branch/jump instruction or an exception
+        state->setNextPc(pc + inst->getOpcodeSize());
+
+        return ++action_it;
+    }
+
+    BasicBlock::FusedInst::CreateAction
+    BasicBlock::FusedInst::getCreateAction(AtlasState* state, const BlockInst & first_inst,
+                                           const BlockInst & second_inst)
+    {
+        // The second instruction must consume the result of the first
+        const AtlasInstPtr & first = first_inst.inst;
+        const AtlasInstPtr & second = second_inst.inst;
+        if ((first->hasRd() == false) || (first->getRd() == 0) || (second->hasRs1() == false)
+            || (second->getRs1() != first->getRd()))
+        {
+            return nullptr;
+        }
+
+        using PairKey = std::pair<mavis::InstructionUniqueID, mavis::InstructionUniqueID>;
+        using enum AtlasState::MavisUIDs;
+        static const std::map<PairKey, CreateAction> fused_pairs = {
+            {{MAVIS_UID_LUI, MAVIS_UID_ADDI},
+             [](FusedInst* fused_inst)
+             { return Action::createAction<&FusedInst::luiAddi_<false>>(fused_inst, "lui+addi"); }},
+            {{MAVIS_UID_LUI, MAVIS_UID_ADDIW},
+             [](FusedInst* fused_inst)
+             { return Action::createAction<&FusedInst::luiAddi_<true>>(fused_inst, "lui+addiw"); }},
+            {{MAVIS_UID_AUIPC, MAVIS_UID_JALR},
+             [](FusedInst* fused_inst)
+             { return Action::createAction<&FusedInst::auipcJalr_>(fused_inst, "auipc+jalr"); }},
+            {{MAVIS_UID_SLLI, MAVIS_UID_SRLI},
+             [](FusedInst* fused_inst)
+             { return Action::createAction<&FusedInst::slliSrli_>(fused_inst, "slli+srli"); }}};
+
+        // Loads are only fused when load/store translation is disabled
+        static const std::map<PairKey, CreateAction> fused_load_pairs = {
+            {{MAVIS_UID_AUIPC, MAVIS_UID_LB},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::auipcLoad_<uint8_t, true>>(fused_inst,
+                                                                                    "auipc+lb");
+             }},
+            {{MAVIS_UID_AUIPC, MAVIS_UID_LBU},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::auipcLoad_<uint8_t, false>>(fused_inst,
+                                                                                     "auipc+lbu");
+             }},
+            {{MAVIS_UID_AUIPC, MAVIS_UID_LH},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::auipcLoad_<uint16_t, true>>(fused_inst,
+                                                                                     "auipc+lh");
+             }},
+            {{MAVIS_UID_AUIPC, MAVIS_UID_LHU},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::auipcLoad_<uint16_t, false>>(
+                     fused_inst, "auipc+lhu");
+             }},
+            {{MAVIS_UID_AUIPC, MAVIS_UID_LW},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::auipcLoad_<uint32_t, true>>(fused_inst,
+                                                                                     "auipc+lw");
+             }},
+            {{MAVIS_UID_AUIPC, MAVIS_UID_LWU},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::auipcLoad_<uint32_t, false>>(
+                     fused_inst, "auipc+lwu");
+             }},
+            {{MAVIS_UID_AUIPC, MAVIS_UID_LD},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::auipcLoad_<uint64_t, false>>(fused_inst,
+                                                                                      "auipc+ld");
+             }},
+            {{MAVIS_UID_ADD, MAVIS_UID_LB},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::addLoad_<uint8_t, true>>(fused_inst,
+                                                                                  "add+lb");
+             }},
+            {{MAVIS_UID_ADD, MAVIS_UID_LBU},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::addLoad_<uint8_t, false>>(fused_inst,
+                                                                                   "add+lbu");
+             }},
+            {{MAVIS_UID_ADD, MAVIS_UID_LH},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::addLoad_<uint16_t, true>>(fused_inst,
+                                                                                   "add+lh");
+             }},
+            {{MAVIS_UID_ADD, MAVIS_UID_LHU},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::addLoad_<uint16_t, false>>(fused_inst,
+                                                                                    "add+lhu");
+             }},
+            {{MAVIS_UID_ADD, MAVIS_UID_LW},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::addLoad_<uint32_t, true>>(fused_inst,
+                                                                                   "add+lw");
+             }},
+            {{MAVIS_UID_ADD, MAVIS_UID_LWU},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::addLoad_<uint32_t, false>>(fused_inst,
+                                                                                    "add+lwu");
+             }},
+            {{MAVIS_UID_ADD, MAVIS_UID_LD},
+             [](FusedInst* fused_inst)
+             {
+                 return Action::createAction<&FusedInst::addLoad_<uint64_t, false>>(fused_inst,
+                                                                                    "add+ld");
+             }}};
+
+        const PairKey key{first->getMavisUid(), second->getMavisUid()};
+        if (auto it = fused_pairs.find(key); it != fused_pairs.end())
+        {
+            // A jump to a 2B aligned target traps without compressed instructions, leave it to
+            // the jalr handler
+            if (key.first == MAVIS_UID_AUIPC)
+            {
+                const Addr jump_target =
+                    (first_inst.pc + first->getImmediate() + second->getImmediate()) & ~Addr(1);
+                if ((jump_target & 0x3) != 0)
+                {
+                    return nullptr;
+                }
+            }
+            return it->second;
+        }
+
+        if (state->getLdstMMUMode() == MMUMode::BAREMETAL)
+        {
+            if (auto it = fused_load_pairs.find(key); it != fused_load_pairs.end())
+            {
+                return it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    template <bool WORD>
+    Action::ItrType BasicBlock::FusedInst::luiAddi_(AtlasState* state, Action::ItrType action_it)
+    {
+        if (SPARTA_EXPECT_FALSE(state->getSimState()->sim_stopped))
+        {
+            return state->redirectActionGroup(state->getStopSimActionGroup());
+        }
+
+        const uint64_t upper = first->getImmediate();
+        const uint64_t sum = upper + second->getImmediate();
+        WRITE_INT_REG<uint64_t>(state, first->getRd(), upper);
+        WRITE_INT_REG<uint64_t>(state, second->getRd(), WORD ? (uint64_t)sext32(sum) : sum);
+        return retire_(state, action_it, second_pc + second->getOpcodeSize());
+    }
+
+    Action::ItrType BasicBlock::FusedInst::auipcJalr_(AtlasState* state, Action::ItrType action_it)
+    {
+        if (SPARTA_EXPECT_FALSE(state->getSimState()->sim_stopped))
+        {
+            return state->redirectActionGroup(state->getStopSimActionGroup());
+        }
+
+        // The target is 4B aligned (checked when the pair was fused), so the jump cannot trap
+        const uint64_t upper = pc + first->getImmediate();
+        const uint64_t jump_target = (upper + second->getImmediate()) & ~uint64_t(1);
+        WRITE_INT_REG<uint64_t>(state, first->getRd(), upper);
+        WRITE_INT_REG<uint64_t>(state, second->getRd(), second_pc + second->getOpcodeSize());
+        return retire_(state, action_it, jump_target);
+    }
+
+    template <typename SIZE, bool SIGN_EXTEND>
+    Action::ItrType BasicBlock::FusedInst::auipcLoad_(AtlasState* state, Action::ItrType action_it)
+    {
+        if (SPARTA_EXPECT_FALSE(state->getSimState()->sim_stopped))
+        {
+            return state->redirectActionGroup(state->getStopSimActionGroup());
+        }
+
+        const uint64_t upper = pc + first->getImmediate();
+        const Addr addr = upper + second->getImmediate();
+
+        // Translate splits page crossing accesses, execute the instructions separately
+        if (SPARTA_EXPECT_FALSE(((addr & (PAGE_SIZE - 1)) + sizeof(SIZE)) > PAGE_SIZE))
+        {
+            return ++action_it;
+        }
+
+        WRITE_INT_REG<uint64_t>(state, first->getRd(), upper);
+        const SIZE value = state->readMemory<SIZE>(addr);
+        WRITE_INT_REG<uint64_t>(state, second->getRd(),
+                                SIGN_EXTEND ? (uint64_t)(int64_t)(std::make_signed_t<SIZE>)value
+                                            : (uint64_t)value);
+        return retire_(state, action_it, second_pc + second->getOpcodeSize());
+    }
+
+    Action::ItrType BasicBlock::FusedInst::slliSrli_(AtlasState* state, Action::ItrType action_it)
+    {
+        if (SPARTA_EXPECT_FALSE(state->getSimState()->sim_stopped))
+        {
+            return state->redirectActionGroup(state->getStopSimActionGroup());
+        }
+
+        const uint64_t rs1_val = READ_INT_REG<uint64_t>(state, first->getRs1());
+        const uint64_t shifted = rs1_val << (first->getImmediate() & 0x3F);
+        WRITE_INT_REG<uint64_t>(state, first->getRd(), shifted);
+        WRITE_INT_REG<uint64_t>(state, second->getRd(),
+                                shifted >> (second->getImmediate() & 0x3F));
+        return retire_(state, action_it, second_pc + second->getOpcodeSize());
+    }
+
+    template <typename SIZE, bool SIGN_EXTEND>
+    Action::ItrType BasicBlock::FusedInst::addLoad_(AtlasState* state, Action::ItrType action_it)
+    {
+        if (SPARTA_EXPECT_FALSE(state->getSimState()->sim_stopped))
+        {
+            return state->redirectActionGroup(state->getStopSimActionGroup());
+        }
+
+        const uint64_t sum = READ_INT_REG<uint64_t>(state, first->getRs1())
+                             + READ_INT_REG<uint64_t>(state, first->getRs2());
+        const Addr addr = sum + second->getImmediate();
+
+        // Translate splits page crossing accesses, execute the instructions separately
+        if (SPARTA_EXPECT_FALSE(((addr & (PAGE_SIZE - 1)) + sizeof(SIZE)) > PAGE_SIZE))
+        {
+            return ++action_it;
+        }
+
+        WRITE_INT_REG<uint64_t>(state, first->getRd(), sum);
+        const SIZE value = state->readMemory<SIZE>(addr);
+        WRITE_INT_REG<uint64_t>(state, second->getRd(),
+                                SIGN_EXTEND ? (uint64_t)(int64_t)(std::make_signed_t<SIZE>)value
+                                            : (uint64_t)value);
+        return retire_(state, action_it, second_pc + second->getOpcodeSize());
+    }
+
+    Action::ItrType BasicBlock::FusedInst::retire_(AtlasState* state, Action::ItrType action_it,
+                                                   const Addr next_pc)
+    {
+        AtlasState::SimState* sim_state = state->getSimState();
+        sim_state->current_opcode = second->getOpcode();
+        sim_state->current_uid += 2;
+        second->reset();
+        state->setCurrentInst(second);
+        state->setNextPc(next_pc);
+        state->setPc(next_pc);
+        sim_state->inst_count += 2;
+
+        return action_it + 1 + num_unfused_actions;
+    }
+} // namespace atlas
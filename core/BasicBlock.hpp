@@ -0,0 +1,159 @@
+#pragma once
+
+#include "core/ActionGroup.hpp"
+#include "core/AtlasInst.hpp"
+#include "include/AtlasTypes.hpp"
+
+#include <vector>
+
+namespace atlas
+{
+    class AtlasState;
+
+    // A straight-line sequence of decoded instructions that ends at a change of flow instruction
+    // (or any instruction that can change how the following instructions are fetched or
+    // decoded). The Actions of every instruction are flattened into a single ActionGroup along
+    // with the Actions that retire the instruction, so the block can be executed without going
+    // through Fetch, Translate, Decode and Execute for every instruction.
+    //
+    // Blocks never cross a page boundary and are only valid for the translation and decode
+    // context they were recorded in. Fetch tags them with the translation context and is
+    // responsible for invalidating them when the decode context changes.
+    class BasicBlock
+    {
+      public:
+        using base_type = BasicBlock;
+
+        static constexpr Addr PAGE_SIZE = 0x1000;
+
+        BasicBlock(const Addr start_pc, const Addr start_paddr);
+
+        Addr getStartPc() const { return start_pc_; }
+
+        // Physical page holding the block's instructions
+        Addr getPhysicalPage() const { return physical_page_; }
+
+        // PC of the instruction following the last instruction in the block
+        Addr getEndPc() const { return end_pc_; }
+
+        uint32_t getNumInsts() const { return insts_.size(); }
+
+        bool empty() const { return insts_.empty(); }
+
+        // Can the instruction be added to the end of the block?
+        bool canAppend(const Addr pc, const AtlasInstPtr & inst) const
+        {
+            const Addr last_byte = pc + inst->getOpcodeSize() - 1;
+            return (closed_ == false) && (pc == end_pc_)
+                   && ((last_byte & ~(PAGE_SIZE - 1)) == start_page_);
+        }
+
+        void addInst(const AtlasInstPtr & inst);
+
+        // The last instruction has been added but it may not have been executed yet
+        void close() { closed_ = true; }
+
+        bool isClosed() const { return closed_; }
+
+        // Build the block's ActionGroup, no more instructions can be added after this. All of the
+        // instructions must be linked with the current link ID. Common pairs of instructions are
+        // fused into a single Action if enabled (fast core only).
+        void finalize(AtlasState* state, ActionGroup* next_action_group, const bool enable_fusion);
+
+        uint32_t getNumFusedPairs() const { return fused_insts_.size(); }
+
+        ActionGroup* getActionGroup() { return &action_group_; }
+
+        // Hotness of the block, used to decide which blocks to evict
+        void countExecution() { ++num_executions_; }
+
+        uint32_t getNumExecutions() const { return num_executions_; }
+
+        // Age the block so that blocks that are no longer executed eventually become cold
+        void decayExecutions() { num_executions_ >>= 1; }
+
+        // Should an instruction terminate the block it is added to?
+        static bool endsBasicBlock(const AtlasInstPtr & inst);
+
+      private:
+        const Addr start_pc_;
+        const Addr start_page_;
+        const Addr physical_page_;
+        Addr end_pc_;
+        bool closed_ = false;
+
+        struct BlockInst
+        {
+            using base_type = BlockInst;
+
+            BlockInst(const Addr pc, const AtlasInstPtr & inst) : pc(pc), inst(inst) {}
+
+            const Addr pc;
+            const AtlasInstPtr inst;
+
+            // Does the work of Fetch and Decode for a cached instruction
+            Action::ItrType beginInst_(AtlasState* state, Action::ItrType action_it);
+        };
+
+        // Addresses of the BlockInsts must not change once the block has been finalized
+        std::vector<BlockInst> insts_;
+
+        // Two consecutive instructions executed by a single Action. The Actions of both
+        // instructions follow the fused Action in the block and are skipped, unless the fused
+        // Action cannot handle the pair (page crossing load), in which case execution falls
+        // through to them.
+        struct FusedInst
+        {
+            using base_type = FusedInst;
+
+            FusedInst(const BlockInst & first_inst, const BlockInst & second_inst) :
+                pc(first_inst.pc),
+                first(first_inst.inst),
+                second_pc(second_inst.pc),
+                second(second_inst.inst)
+            {
+            }
+
+            const Addr pc;
+            const AtlasInstPtr first;
+            const Addr second_pc;
+            const AtlasInstPtr second;
+            uint32_t num_unfused_actions = 0;
+
+            using CreateAction = Action (*)(FusedInst* fused_inst);
+
+            // Returns nullptr if the instructions cannot be fused
+            static CreateAction getCreateAction(AtlasState* state, const BlockInst & first,
+                                                const BlockInst & second);
+
+            // lui+addi, lui+addiw
+            template <bool WORD>
+            Action::ItrType luiAddi_(AtlasState* state, Action::ItrType action_it);
+
+            // auipc+jalr, only fused if the jump target is 4B aligned
+            Action::ItrType auipcJalr_(AtlasState* state, Action::ItrType action_it);
+
+            // auipc+load (PC relative load)
+            template <typename SIZE, bool SIGN_EXTEND>
+            Action::ItrType auipcLoad_(AtlasState* state, Action::ItrType action_it);
+
+            // slli+srli (zero extension)
+            Action::ItrType slliSrli_(AtlasState* state, Action::ItrType action_it);
+
+            // add+load (indexed load)
+            template <typename SIZE, bool SIGN_EXTEND>
+            Action::ItrType addLoad_(AtlasState* state, Action::ItrType action_it);
+
+            // Retire both instructions and skip their Actions
+            Action::ItrType retire_(AtlasState* state, Action::ItrType action_it,
+                                    const Addr next_pc);
+        };
+
+        // Addresses of the FusedInsts must not change once the block has been finalized
+        std::vector<FusedInst> fused_insts_;
+
+        ActionGroup action_group_;
+
+        uint32_t num_executions_ = 0;
+    };
+} // namespace atlas
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "include/AtlasTypes.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace atlas
+{
+    /*!
+     * \class CodePageFilter
+     * \brief Physical pages that may hold the instructions of cached basic blocks
+     *
+     * Every store checks the bytes it writes against the filter, so it is a small bitmap indexed
+     * by physical page number instead of an exact set. Pages that share a bit are false
+     * positives, Fetch keeps the exact set of blocks on each page.
+     */
+    class CodePageFilter
+    {
+      public:
+        static constexpr Addr PAGE_SIZE = 0x1000;
+
+        static Addr getPage(const Addr paddr) { return paddr & ~(PAGE_SIZE - 1); }
+
+        // Returns true if the store of size bytes at paddr may write a code page. Stores are never
+        // larger than a page, so only the first and last byte need to be checked.
+        bool mayContain(const Addr paddr, const size_t size) const
+        {
+            return isSet_(paddr) || isSet_(paddr + size - 1);
+        }
+
+        void add(const Addr paddr)
+        {
+            const uint32_t bit = getBit_(paddr);
+            bits_[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+
+        void clear() { bits_.fill(0); }
+
+      private:
+        static constexpr uint32_t NUM_BITS = 4096;
+
+        static uint32_t getBit_(const Addr paddr) { return (paddr / PAGE_SIZE) % NUM_BITS; }
+
+        bool isSet_(const Addr paddr) const
+        {
+            const uint32_t bit = getBit_(paddr);
+            return (bits_[bit / 64] >> (bit % 64)) & 1;
+        }
+
+        std::array<uint64_t, NUM_BITS / 64> bits_{};
+    };
+} // namespace atlas
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "core/AtlasInst.hpp"
+#include "include/AtlasTypes.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <vector>
+
+namespace atlas
+{
+    // Direct-mapped cache of decoded instructions. Entries are indexed by the physical address of
+    // the instruction and tagged with the physical address, the raw opcode and the Mavis context
+    // the instruction was decoded in. Keying on the physical address lets virtual aliases of a
+    // code page share entries and keeps remapped pages from hitting stale ones. The opcode is
+    // always read from memory before the lookup, so self-modifying code simply misses.
+    class DecodeCache
+    {
+      public:
+        DecodeCache(const uint32_t num_entries) : entries_(num_entries), index_mask_(num_entries - 1)
+        {
+            sparta_assert((num_entries != 0) && ((num_entries & (num_entries - 1)) == 0),
+                          "Decode cache size must be a power of 2: " << num_entries);
+        }
+
+        const AtlasInstPtr & lookup(const Addr paddr, const Opcode opcode,
+                                    const uint32_t context_id) const
+        {
+            static const AtlasInstPtr no_inst;
+            const Entry & entry = entries_[getIndex_(paddr)];
+            if ((entry.paddr == paddr) && (entry.opcode == opcode)
+                && (entry.context_id == context_id))
+            {
+                return entry.inst;
+            }
+            return no_inst;
+        }
+
+        void allocate(const Addr paddr, const Opcode opcode, const uint32_t context_id,
+                      const AtlasInstPtr & inst)
+        {
+            Entry & entry = entries_[getIndex_(paddr)];
+            entry.paddr = paddr;
+            entry.opcode = opcode;
+            entry.context_id = context_id;
+            entry.inst = inst;
+        }
+
+        void invalidate()
+        {
+            for (auto & entry : entries_)
+            {
+                entry = Entry();
+            }
+        }
+
+        uint32_t size() const { return entries_.size(); }
+
+      private:
+        struct Entry
+        {
+            Addr paddr = 0;
+            Opcode opcode = 0;
+            uint32_t context_id = 0;
+            AtlasInstPtr inst = nullptr;
+        };
+
+        std::vector<Entry> entries_;
+        const uint64_t index_mask_;
+
+        // Compressed instructions are 2B aligned
+        uint64_t getIndex_(const Addr paddr) const { return (paddr >> 1) & index_mask_; }
+    };
+} // namespace atlas
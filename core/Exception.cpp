@@ -80,14 +80,14 @@ namespace atlas
             WRITE_CSR_REG<XLEN>(state, STVAL, trap_val);
 
             // Update MSTATUS
-            const auto mstatus_sie = READ_CSR_FIELD<XLEN>(state, MSTATUS, "sie");
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "spie", mstatus_sie);
+            const auto mstatus_sie = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::sie>(state);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::spie>(state, mstatus_sie);
 
             const auto spp_val = static_cast<XLEN>(state->getPrivMode());
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "spp", spp_val);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::spp>(state, spp_val);
 
             const uint64_t sie_val = 0;
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sie", sie_val);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::sie>(state, sie_val);
         }
         else if (priv_mode == PrivMode::MACHINE)
         {
@@ -111,26 +111,26 @@ namespace atlas
             WRITE_CSR_REG<XLEN>(state, MTVAL, trap_val);
 
             // Update MSTATUS
-            const auto mstatus_mie = READ_CSR_FIELD<XLEN>(state, MSTATUS, "mie");
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpie", mstatus_mie);
+            const auto mstatus_mie = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mie>(state);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpie>(state, mstatus_mie);
 
             const auto mpp_val = static_cast<XLEN>(state->getPrivMode());
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpp", mpp_val);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpp>(state, mpp_val);
 
             const uint64_t mie_val = 0;
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mie", mie_val);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mie>(state, mie_val);
 
             const uint64_t mpv_val = 0;
             const uint64_t gva_val = 0;
             if constexpr (std::is_same_v<XLEN, RV64>)
             {
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpv", mpv_val);
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "gva", gva_val);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpv>(state, mpv_val);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::gva>(state, gva_val);
             }
             else
             {
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUSH, "mpv", mpv_val);
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUSH, "gva", gva_val);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUSH::mpv>(state, mpv_val);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUSH::gva>(state, gva_val);
             }
         }
         state->setPrivMode(priv_mode, prev_virt_mode);
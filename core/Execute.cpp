@@ -100,10 +100,31 @@ namespace atlas
 
     Action::ItrType Execute::execute_(AtlasState* state, Action::ItrType action_it)
     {
-        // Connect instruction to Fetch
-        const auto inst = state->getCurrentInst();
+        const AtlasInstPtr & inst = state->getCurrentInst();
+
+        // Instructions are normally linked by Fetch when they are decoded
+        if (SPARTA_EXPECT_FALSE(inst->isLinked(state->getLinkId()) == false))
+        {
+            linkInst(state, inst);
+        }
+
+        // Connect instruction to Fetch, wfi redirects it to the stop sim ActionGroup
+        ActionGroup* inst_action_group = inst->getActionGroup();
+        inst_action_group->setNextActionGroup(state->getInstNextActionGroup());
+
+        ILOG(inst);
+
+        // Execute the instruction
+        execute_action_group_.setNextActionGroup(inst_action_group);
+        return ++action_it;
+    }
+
+    void Execute::linkInst(AtlasState* state, const AtlasInstPtr & inst)
+    {
+        // Start over from the Actions created by Mavis
+        inst->unlink();
+
         ActionGroup* inst_action_group = inst->getActionGroup();
-        inst_action_group->setNextActionGroup(state->getFinishActionGroup());
 
         // Insert translation Action into instruction's ActionGroup between the compute address
         // handler and the execute handler
@@ -135,10 +156,6 @@ namespace atlas
 
         state->insertExecuteActions(inst_action_group);
 
-        ILOG(inst);
-
-        // Execute the instruction
-        execute_action_group_.setNextActionGroup(inst_action_group);
-        return ++action_it;
+        inst->setLinked(state->getLinkId());
     }
 } // namespace atlas
@@ -6,10 +6,13 @@
 #include "sparta/simulation/ParameterSet.hpp"
 #include "sparta/simulation/TreeNode.hpp"
 #include "sparta/simulation/Unit.hpp"
+#include "sparta/utils/SpartaSharedPointer.hpp"
 
 namespace atlas
 {
     class AtlasState;
+    class AtlasInst;
+    using AtlasInstPtr = sparta::SpartaSharedPointer<AtlasInst>;
 
     class Execute : public sparta::Unit
     {
@@ -32,6 +35,11 @@ namespace atlas
 
         bool getSystemCallEmulation() const { return enable_syscall_emulation_; }
 
+        // Build the instruction's ActionGroup with the translate, CSR update and observer Actions
+        // for the current link ID. Instructions are linked when they are decoded and relinked
+        // only after the link ID changes (MMU mode, observers or CSR update Actions changed).
+        void linkInst(AtlasState* state, const AtlasInstPtr & inst);
+
         using InstHandlersMap = std::map<std::string, Action>;
         using CsrUpdateActionsMap = std::map<uint32_t, Action>;
 
@@ -9,10 +9,60 @@
 #include "sparta/simulation/ResourceTreeNode.hpp"
 #include "sparta/utils/LogUtils.hpp"
 
+#include <algorithm>
+
 namespace atlas
 {
-    Fetch::Fetch(sparta::TreeNode* fetch_node, const FetchParameters*) : sparta::Unit(fetch_node)
+    Fetch::Fetch(sparta::TreeNode* fetch_node, const FetchParameters* p) :
+        sparta::Unit(fetch_node),
+        decode_cache_(p->decode_cache_size),
+        decode_cache_hits_(getStatisticSet(), "decode_cache_hits",
+                           "Number of instructions found in the decode cache",
+                           sparta::Counter::COUNT_NORMAL),
+        decode_cache_misses_(getStatisticSet(), "decode_cache_misses",
+                             "Number of instructions decoded by Mavis",
+                             sparta::Counter::COUNT_NORMAL),
+        enable_block_execution_(p->enable_block_execution),
+        enable_threaded_dispatch_(p->enable_threaded_dispatch),
+        code_page_invalidations_(getStatisticSet(), "code_page_invalidations",
+                                 "Number of pages whose blocks were invalidated by a store",
+                                 sparta::Counter::COUNT_NORMAL),
+        translated_block_invalidations_(
+            getStatisticSet(), "translated_block_invalidations",
+            "Number of basic blocks invalidated by sfence.vma", sparta::Counter::COUNT_NORMAL),
+        basic_blocks_executed_(getStatisticSet(), "basic_blocks_executed",
+                               "Number of cached basic blocks executed",
+                               sparta::Counter::COUNT_NORMAL),
+        basic_blocks_created_(getStatisticSet(), "basic_blocks_created",
+                              "Number of basic blocks recorded", sparta::Counter::COUNT_NORMAL),
+        basic_blocks_evicted_(getStatisticSet(), "basic_blocks_evicted",
+                              "Number of basic blocks evicted from the full block cache",
+                              sparta::Counter::COUNT_NORMAL),
+        enable_fusion_(p->enable_fusion),
+        fused_inst_pairs_(getStatisticSet(), "fused_inst_pairs",
+                          "Number of instruction pairs fused in recorded basic blocks",
+                          sparta::Counter::COUNT_NORMAL),
+        block_threshold_(p->block_threshold),
+        block_cache_capacity_(p->block_cache_capacity),
+        interpreted_insts_(getStatisticSet(), "interpreted_insts",
+                           "Number of instructions retired by the interpreter",
+                           sparta::Counter::COUNT_NORMAL),
+        block_insts_(getStatisticSet(), "block_insts",
+                     "Number of instructions retired by cached basic blocks",
+                     sparta::Counter::COUNT_NORMAL),
+        interpreted_fraction_(getStatisticSet(), "interpreted_fraction",
+                              "Fraction of instructions retired by the interpreter",
+                              getStatisticSet(),
+                              "interpreted_insts/(interpreted_insts+block_insts)",
+                              sparta::StatisticDef::VS_FRACTIONAL),
+        block_fraction_(getStatisticSet(), "block_fraction",
+                        "Fraction of instructions retired by cached basic blocks",
+                        getStatisticSet(),
+                        "block_insts/(interpreted_insts+block_insts)",
+                        sparta::StatisticDef::VS_FRACTIONAL)
     {
+        sparta_assert(block_cache_capacity_ > 0, "The block cache capacity must not be 0");
+
         Action fetch_action =
             atlas::Action::createAction<&Fetch::fetch_>(this, "fetch", ActionTags::FETCH_TAG);
         fetch_action_group_.addAction(fetch_action);
@@ -48,6 +98,13 @@ namespace atlas
 
         // Reset the sim state
         AtlasState::SimState* sim_state = state->getSimState();
+
+        // The fast core does not go through the finish ActionGroup, which is redirected to the
+        // stop sim ActionGroup when simulation is stopped
+        if (SPARTA_EXPECT_FALSE(sim_state->sim_stopped))
+        {
+            return state->redirectActionGroup(state->getStopSimActionGroup());
+        }
         sim_state->reset();
 
         AtlasTranslationState* translation_state = state->getFetchTranslationState();
@@ -100,8 +157,9 @@ namespace atlas
         OpcodeSize opcode_size = 4;
         if (SPARTA_EXPECT_TRUE(!page_crossing_access))
         {
+            inst_paddr_ = result.getPAddr();
             // TBD: Opcode opcode = result.readMemory<Opcode>(result.physical_addr);
-            opcode = state->readMemory<uint32_t>(result.getPAddr());
+            opcode = state->readMemory<uint32_t>(inst_paddr_);
 
             // Compression detection
             if ((opcode & 0x3) != 0x3)
@@ -115,13 +173,14 @@ namespace atlas
             if (opcode == 0)
             {
                 // Load the first 2B, could be a valid 2B compressed inst
-                opcode = state->readMemory<uint16_t>(result.getPAddr());
+                inst_paddr_ = result.getPAddr();
+                opcode = state->readMemory<uint16_t>(inst_paddr_);
                 opcode_size = 2;
 
                 if ((opcode & 0x3) == 0x3)
                 {
                     // Go back to inst translate
-                    throw ActionException(fetch_action_group_.getNextActionGroup());
+                    return state->redirectActionGroup(fetch_action_group_.getNextActionGroup());
                 }
             }
             else
@@ -133,21 +192,41 @@ namespace atlas
 
         ++(state->getSimState()->current_uid);
 
-        // Decode instruction with Mavis
-        AtlasInstPtr inst = nullptr;
-        try
+        // Look for a previously decoded instruction, otherwise decode instruction with Mavis
+        const Addr pc = state->getPc();
+        const uint32_t mavis_context_id = state->getMavisContextId();
+        AtlasInstPtr inst = decode_cache_.lookup(inst_paddr_, opcode, mavis_context_id);
+        if (SPARTA_EXPECT_TRUE(inst != nullptr))
         {
-            inst = state->getMavis()->makeInst(opcode, state);
-            assert(state->getCurrentInst() == nullptr);
-            state->setCurrentInst(inst);
-            // Set next PC, can be overidden by a branch/jump instruction or an exception
-            state->setNextPc(state->getPc() + opcode_size);
+            ++decode_cache_hits_;
+            inst->reset();
         }
-        catch (const mavis::BaseException & e)
+        else
         {
-            THROW_ILLEGAL_INST;
+            ++decode_cache_misses_;
+            try
+            {
+                inst = state->getMavis()->makeInst(opcode, state);
+            }
+            catch (const mavis::BaseException & e)
+            {
+                THROW_ILLEGAL_INST;
+            }
+            decode_cache_.allocate(inst_paddr_, opcode, mavis_context_id, inst);
         }
 
+        // Link the translate, CSR update and observer Actions into the instruction once instead of
+        // on every execution
+        if (SPARTA_EXPECT_FALSE(inst->isLinked(state->getLinkId()) == false))
+        {
+            state->getExecuteUnit()->linkInst(state, inst);
+        }
+
+        assert(state->getCurrentInst() == nullptr);
+        state->setCurrentInst(inst);
+        // Set next PC, can be overidden by a branch/jump instruction or an exception
+        state->setNextPc(pc + opcode_size);
+
         // If we only fetched 2B and found a valid compressed inst, then cancel the translation
         // request for the second 2B
         if (page_crossing_access && (opcode_size == 2))
@@ -167,7 +246,7 @@ namespace atlas
             // TODO: This is probably not the best place for this check...
             if (csr == SATP)
             {
-                const uint32_t tvm_val = READ_CSR_FIELD<RV64>(state, MSTATUS, "tvm");
+                const uint32_t tvm_val = READ_CSR_FIELD<RV64, CSR_FIELDS::MSTATUS::tvm>(state);
                 if ((state->getPrivMode() == PrivMode::SUPERVISOR) && tvm_val)
                 {
                     THROW_ILLEGAL_INST;
@@ -175,17 +254,417 @@ namespace atlas
             }
         }
 
+        if (block_recording_)
+        {
+            recordInst_(pc, inst_paddr_, inst);
+        }
+
         return ++action_it;
     }
 
+    void Fetch::recordInst_(const Addr pc, const Addr paddr, const AtlasInstPtr & inst)
+    {
+        // Instruction does not directly follow the block being recorded (trap, page boundary)
+        if (recording_block_ && (recording_block_->canAppend(pc, inst) == false))
+        {
+            finalizeRecordingBlock_();
+        }
+
+        if (recording_block_ == nullptr)
+        {
+            recording_block_ = std::make_unique<BasicBlock>(pc, paddr);
+            recording_block_context_id_ = block_context_id_;
+
+            // Instruction crosses a page boundary, execute it the slow way
+            if (recording_block_->canAppend(pc, inst) == false)
+            {
+                recording_block_.reset();
+                return;
+            }
+        }
+
+        recording_block_->addInst(inst);
+
+        // The block is finalized after this instruction has been executed
+        if (BasicBlock::endsBasicBlock(inst))
+        {
+            recording_block_->close();
+        }
+    }
+
+    void Fetch::finalizeRecordingBlock_()
+    {
+        sparta_assert(recording_block_ != nullptr);
+        const BlockKey key{recording_block_->getStartPc(), recording_block_context_id_};
+
+        // A block may have been recorded for this PC while another block was being recorded
+        // (e.g. a jump into the middle of the block being recorded)
+        if (block_cache_.contains(key) == false)
+        {
+            // Blocks stay in the interpreter until they have been entered often enough
+            uint32_t & num_entries = block_entries_[key];
+            if (++num_entries >= block_threshold_)
+            {
+                block_entries_.erase(key);
+                recording_block_->finalize(state_, &fetch_action_group_, enable_fusion_);
+                fused_inst_pairs_ += recording_block_->getNumFusedPairs();
+
+                // Stores to the block's page invalidate it
+                const Addr physical_page = recording_block_->getPhysicalPage();
+                code_page_filter_.add(physical_page);
+                code_page_blocks_[physical_page].emplace_back(key);
+
+                block_cache_.emplace(key, std::move(recording_block_));
+                ++basic_blocks_created_;
+            }
+        }
+        recording_block_.reset();
+    }
+
+    void Fetch::setBlockContext(const BlockContext & block_context)
+    {
+        if (block_context == block_context_)
+        {
+            return;
+        }
+
+        block_context_ = block_context;
+        const auto [it, inserted] =
+            block_context_ids_.try_emplace(block_context, block_context_ids_.size());
+        if (inserted)
+        {
+            block_contexts_.emplace_back(block_context);
+        }
+        block_context_id_ = it->second;
+    }
+
+    void Fetch::evictColdBlocks_()
+    {
+        // Evict the coldest half of the blocks
+        std::vector<std::pair<uint32_t, BlockKey>> blocks_by_hotness;
+        blocks_by_hotness.reserve(block_cache_.size());
+        for (const auto & [key, block] : block_cache_)
+        {
+            blocks_by_hotness.emplace_back(block->getNumExecutions(), key);
+        }
+
+        const auto middle_it = blocks_by_hotness.begin() + (blocks_by_hotness.size() / 2);
+        std::nth_element(blocks_by_hotness.begin(), middle_it, blocks_by_hotness.end(),
+                         [](const auto & a, const auto & b) { return a.first < b.first; });
+        for (auto it = blocks_by_hotness.begin(); it != middle_it; ++it)
+        {
+            block_cache_.erase(it->second);
+            ++basic_blocks_evicted_;
+        }
+
+        // Age the remaining blocks, the code pages are rebuilt from the remaining blocks
+        clearCodePages_();
+        for (auto & [key, block] : block_cache_)
+        {
+            code_page_filter_.add(block->getPhysicalPage());
+            code_page_blocks_[block->getPhysicalPage()].emplace_back(key);
+            block->decayExecutions();
+        }
+    }
+
+    void Fetch::invalidateCodePages(const Addr paddr, const size_t size)
+    {
+        for (const Addr physical_page :
+             {CodePageFilter::getPage(paddr), CodePageFilter::getPage(paddr + size - 1)})
+        {
+            if (code_page_blocks_.contains(physical_page))
+            {
+                stale_code_pages_.emplace_back(physical_page);
+            }
+
+            // The block being recorded may include instructions that are no longer in memory
+            if (recording_block_ && (recording_block_->getPhysicalPage() == physical_page))
+            {
+                recording_block_.reset();
+            }
+        }
+    }
+
+    void Fetch::invalidateStaleCodePages_()
+    {
+        for (const Addr physical_page : stale_code_pages_)
+        {
+            const auto page_it = code_page_blocks_.find(physical_page);
+            if (page_it == code_page_blocks_.end())
+            {
+                continue;
+            }
+
+            for (const BlockKey & key : page_it->second)
+            {
+                block_cache_.erase(key);
+            }
+            code_page_blocks_.erase(page_it);
+            ++code_page_invalidations_;
+        }
+        stale_code_pages_.clear();
+    }
+
+    void Fetch::invalidateTranslatedBlocks(const std::optional<Addr> & vaddr,
+                                           const std::optional<uint32_t> & asid)
+    {
+        translation_flushes_.emplace_back(TranslationFlush{vaddr, asid});
+
+        // The instructions of the block being recorded may have been fetched through a flushed
+        // translation
+        recording_block_.reset();
+    }
+
+    void Fetch::invalidateTranslatedBlocks_()
+    {
+        // Blocks are tagged with the context they were recorded in, so a block can only have been
+        // fetched through a flushed translation if it was recorded with translated fetch in the
+        // flushed address space. Blocks only record their start PC and their page size is
+        // unknown, so a flush by address invalidates the blocks in the largest page of the MMU
+        // mode that contains the address.
+        auto is_flushed = [this](const BlockKey & key, const TranslationFlush & flush)
+        {
+            const BlockContext & context = block_contexts_[key.context_id];
+            if (context.fetch_mode == MMUMode::BAREMETAL)
+            {
+                return false;
+            }
+            if (flush.asid && (*flush.asid != context.asid))
+            {
+                return false;
+            }
+            if (flush.vaddr)
+            {
+                const Addr page_mask = ~getMaxPageOffsetMask_(context.fetch_mode);
+                return (key.pc & page_mask) == (*flush.vaddr & page_mask);
+            }
+            return true;
+        };
+
+        translated_block_invalidations_ += std::erase_if(
+            block_cache_,
+            [this, &is_flushed](const auto & key_block)
+            {
+                return std::any_of(translation_flushes_.begin(), translation_flushes_.end(),
+                                   [&key_block, &is_flushed](const TranslationFlush & flush)
+                                   { return is_flushed(key_block.first, flush); });
+            });
+        translation_flushes_.clear();
+    }
+
+    Addr Fetch::getMaxPageOffsetMask_(const MMUMode mode)
+    {
+        switch (mode)
+        {
+            case MMUMode::SV32:
+                return translate_types::Sv32::page_offset_masks.back();
+            case MMUMode::SV39:
+                return translate_types::Sv39::page_offset_masks.back();
+            case MMUMode::SV48:
+                return translate_types::Sv48::page_offset_masks.back();
+            case MMUMode::SV57:
+                return translate_types::Sv57::page_offset_masks.back();
+            default:
+                return std::numeric_limits<Addr>::max();
+        }
+    }
+
+    void Fetch::clearCodePages_()
+    {
+        code_page_filter_.clear();
+        code_page_blocks_.clear();
+        stale_code_pages_.clear();
+    }
+
+    void Fetch::switchTier_(sparta::Counter* tier_insts)
+    {
+        if (tier_insts != tier_insts_)
+        {
+            updateTierInsts_();
+            tier_insts_ = tier_insts;
+        }
+    }
+
+    void Fetch::updateTierInsts_()
+    {
+        const uint64_t inst_count = state_->getSimState()->inst_count;
+        *tier_insts_ += inst_count - tier_start_inst_count_;
+        tier_start_inst_count_ = inst_count;
+    }
+
+    ActionGroup* Fetch::lookupBlock_()
+    {
+        // Safe to free the blocks now that none of them are executing
+        if (SPARTA_EXPECT_FALSE(block_cache_flush_pending_))
+        {
+            block_cache_.clear();
+            clearCodePages_();
+            translation_flushes_.clear();
+            block_cache_flush_pending_ = false;
+        }
+        else
+        {
+            if (SPARTA_EXPECT_FALSE(stale_code_pages_.empty() == false))
+            {
+                invalidateStaleCodePages_();
+            }
+            if (SPARTA_EXPECT_FALSE(translation_flushes_.empty() == false))
+            {
+                invalidateTranslatedBlocks_();
+            }
+            if (SPARTA_EXPECT_FALSE(block_cache_.size() > block_cache_capacity_))
+            {
+                evictColdBlocks_();
+            }
+        }
+
+        // Simulation was stopped by the last instruction of the previous block
+        AtlasState::SimState* sim_state = state_->getSimState();
+        if (SPARTA_EXPECT_FALSE(sim_state->sim_stopped))
+        {
+            return state_->getStopSimActionGroup();
+        }
+
+        if (recording_block_ && recording_block_->isClosed())
+        {
+            finalizeRecordingBlock_();
+        }
+
+        const auto block_it = block_cache_.find(BlockKey{state_->getPc(), block_context_id_});
+        if (block_it != block_cache_.end())
+        {
+            // Fell through into an existing block
+            if (recording_block_)
+            {
+                finalizeRecordingBlock_();
+            }
+
+            // Execute one instruction at a time up to the next instruction count event
+            BasicBlock* block = block_it->second.get();
+            if (SPARTA_EXPECT_FALSE((sim_state->inst_count + block->getNumInsts())
+                                    > next_inst_count_event_))
+            {
+                switchTier_(&interpreted_insts_);
+                return &fetch_action_group_;
+            }
+
+            block->countExecution();
+            ++basic_blocks_executed_;
+            switchTier_(&block_insts_);
+            return block->getActionGroup();
+        }
+
+        switchTier_(&interpreted_insts_);
+        return &fetch_action_group_;
+    }
+
+    void Fetch::addInstCountEvent(const uint64_t inst_count, const std::function<void()> & callback)
+    {
+        inst_count_events_.emplace(inst_count, callback);
+        next_inst_count_event_ = inst_count_events_.begin()->first;
+    }
+
+    void Fetch::handleInstCountEvents_()
+    {
+        const uint64_t inst_count = state_->getSimState()->inst_count;
+        while ((inst_count_events_.empty() == false)
+               && (inst_count_events_.begin()->first <= inst_count))
+        {
+            // The callback may add more events
+            const std::function<void()> callback = std::move(inst_count_events_.begin()->second);
+            inst_count_events_.erase(inst_count_events_.begin());
+            callback();
+        }
+
+        next_inst_count_event_ = inst_count_events_.empty()
+                                     ? std::numeric_limits<uint64_t>::max()
+                                     : inst_count_events_.begin()->first;
+    }
+
+    bool Fetch::runQuantum(const uint64_t num_insts)
+    {
+        if (hart_stopped_)
+        {
+            return false;
+        }
+
+        quantum_expired_ = false;
+        addInstCountEvent(state_->getSimState()->inst_count + num_insts,
+                          [this]() { quantum_expired_ = true; });
+        hart_stopped_ = (runHart_() == false);
+        return !hart_stopped_;
+    }
+
     void Fetch::advanceSim_()
     {
-        // Run
+        if (startup_handler_)
+        {
+            startup_handler_();
+            return;
+        }
+
+        hart_stopped_ = (runHart_() == false);
+        // End of sim
+    }
+
+    bool Fetch::runHart_()
+    {
+        // Other harts may have run on this thread since this hart last ran
+        state_->loadSoftfloatState();
+
+        bool running = false;
+        if (enable_block_execution_)
+        {
+            running = enable_threaded_dispatch_ ? run_<true, true>() : run_<true, false>();
+        }
+        else
+        {
+            running = enable_threaded_dispatch_ ? run_<false, true>() : run_<false, false>();
+        }
+
+        state_->saveSoftfloatState();
+        return running;
+    }
+
+    template <bool BLOCK_EXECUTION, bool THREADED_DISPATCH> bool Fetch::run_()
+    {
+        block_recording_ = BLOCK_EXECUTION;
+
+        const AtlasState::SimState* sim_state = state_->getSimState();
         ActionGroup* next_action_group = &fetch_action_group_;
         while (next_action_group)
         {
-            next_action_group = next_action_group->execute(state_);
+            if (next_action_group == &fetch_action_group_)
+            {
+                if (SPARTA_EXPECT_FALSE(sim_state->inst_count >= next_inst_count_event_))
+                {
+                    handleInstCountEvents_();
+
+                    // Resume from Fetch in the next quantum
+                    if (quantum_expired_)
+                    {
+                        break;
+                    }
+                }
+
+                if constexpr (BLOCK_EXECUTION)
+                {
+                    next_action_group = lookupBlock_();
+                }
+            }
+
+            if constexpr (THREADED_DISPATCH)
+            {
+                next_action_group = next_action_group->executeThreaded(state_);
+            }
+            else
+            {
+                next_action_group = next_action_group->execute(state_);
+            }
         }
-        // End of sim
+
+        block_recording_ = false;
+        updateTierInsts_();
+        return next_action_group != nullptr;
     }
 } // namespace atlas
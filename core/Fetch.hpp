@@ -1,10 +1,22 @@
 #pragma once
 
 #include "core/ActionGroup.hpp"
+#include "core/BasicBlock.hpp"
+#include "core/CodePageFilter.hpp"
+#include "core/DecodeCache.hpp"
 
 #include "sparta/simulation/ParameterSet.hpp"
 #include "sparta/simulation/TreeNode.hpp"
 #include "sparta/simulation/Unit.hpp"
+#include "sparta/statistics/Counter.hpp"
+#include "sparta/statistics/StatisticDef.hpp"
+
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace atlas
 {
@@ -21,12 +33,89 @@ namespace atlas
         {
           public:
             FetchParameters(sparta::TreeNode* node) : sparta::ParameterSet(node) {}
+
+            PARAMETER(uint32_t, decode_cache_size, 4096,
+                      "Number of entries in the decoded instruction cache (power of 2)")
+            PARAMETER(bool, enable_block_execution, true,
+                      "Execute straight-line code as cached basic blocks")
+            PARAMETER(uint32_t, block_threshold, 2,
+                      "Number of times a basic block is entered before it is cached")
+            PARAMETER(uint32_t, block_cache_capacity, 16384,
+                      "Maximum number of cached basic blocks, the coldest half is evicted when "
+                      "the cache is full")
+            PARAMETER(bool, enable_threaded_dispatch, false,
+                      "Execute Actions with direct threaded dispatch instead of the ActionGroup "
+                      "loop")
+            PARAMETER(bool, enable_fusion, true,
+                      "Fuse common instruction pairs (lui+addi, auipc+jalr, auipc+load, "
+                      "slli+srli, add+load) in cached basic blocks (no observers only)")
         };
 
         Fetch(sparta::TreeNode* fetch_node, const FetchParameters* p);
 
         ActionGroup* getActionGroup() { return &fetch_action_group_; }
 
+        // Drop all cached instructions
+        void invalidateDecodeCache() { decode_cache_.invalidate(); }
+
+        // Drop all cached basic blocks. Since this can be called by an instruction executing
+        // from a basic block, the blocks are not freed until the next block lookup.
+        void invalidateBlockCache()
+        {
+            block_cache_flush_pending_ = true;
+            recording_block_.reset();
+        }
+
+        // Translation state that basic blocks depend on. Blocks skip instruction translation and
+        // have the load/store translate Actions linked in, so they are tagged with the context
+        // they were recorded in and only executed in that context. Traps and xrets switch
+        // between contexts without invalidating any blocks.
+        struct BlockContext
+        {
+            PrivMode priv_mode = PrivMode::MACHINE;
+            uint64_t satp = 0; // 0 when instruction translation is disabled
+            MMUMode fetch_mode = MMUMode::BAREMETAL;
+            uint32_t asid = 0;
+            MMUMode ls_mode = MMUMode::INVALID;
+            bool tvm = false;  // Checked by Decode for satp accesses
+
+            auto operator<=>(const BlockContext &) const = default;
+        };
+
+        // Called by AtlasState whenever the MMU mode may have changed
+        void setBlockContext(const BlockContext & block_context);
+
+        // Called by sfence.vma. Invalidates the blocks that may have been fetched through the
+        // flushed translations, see TLB::flush. Like invalidateBlockCache, the blocks are not
+        // freed until the next block lookup.
+        void invalidateTranslatedBlocks(const std::optional<Addr> & vaddr,
+                                        const std::optional<uint32_t> & asid);
+
+        // Pages holding the instructions of cached blocks, checked by every store
+        const CodePageFilter* getCodePageFilter() const { return &code_page_filter_; }
+
+        // Called after this hart stored size bytes at paddr to a page that may hold cached
+        // blocks. The blocks on the page are invalidated at the next block lookup, so a store
+        // that modifies the block it is executing from takes effect once the block ends.
+        void invalidateCodePages(const Addr paddr, const size_t size);
+
+        // Call a function once the number of retired instructions reaches inst_count, e.g. to
+        // stop simulation or to add an observer after a warmup. The count is only checked
+        // between basic blocks, blocks that would run past it are executed one instruction at a
+        // time instead.
+        void addInstCountEvent(const uint64_t inst_count, const std::function<void()> & callback);
+
+        // Run this hart until num_insts more instructions have retired or it stops, then return
+        // so another hart can run. Returns false once the hart has stopped.
+        bool runQuantum(const uint64_t num_insts);
+
+        // By default every hart runs to completion from a startup event. Multi-hart simulations
+        // replace the startup event handler with one that interleaves the harts.
+        void setStartupHandler(const std::function<void()> & handler)
+        {
+            startup_handler_ = handler;
+        }
+
       private:
         AtlasState* state_ = nullptr;
 
@@ -40,6 +129,133 @@ namespace atlas
 
         ActionGroup decode_action_group_{"Decode"};
 
+        // Decoded instruction cache
+        DecodeCache decode_cache_;
+
+        // Physical address of the instruction being decoded (of its first 2B if it crosses a page)
+        Addr inst_paddr_ = 0;
+
+        sparta::Counter decode_cache_hits_;
+        sparta::Counter decode_cache_misses_;
+
+        // Basic block execution
+        const bool enable_block_execution_;
+        const bool enable_threaded_dispatch_;
+        bool block_recording_ = false;
+        bool block_cache_flush_pending_ = false;
+
+        // Blocks are cached by start PC and block context
+        struct BlockKey
+        {
+            Addr pc;
+            uint32_t context_id;
+
+            bool operator==(const BlockKey &) const = default;
+        };
+
+        struct BlockKeyHash
+        {
+            size_t operator()(const BlockKey & key) const
+            {
+                return std::hash<Addr>()(key.pc ^ (Addr(key.context_id) << 48));
+            }
+        };
+
+        std::unordered_map<BlockKey, std::unique_ptr<BasicBlock>, BlockKeyHash> block_cache_;
+        std::unique_ptr<BasicBlock> recording_block_;
+        uint32_t recording_block_context_id_ = 0;
+
+        // Blocks on each physical page, may include blocks that have been evicted since
+        CodePageFilter code_page_filter_;
+        std::unordered_map<Addr, std::vector<BlockKey>> code_page_blocks_;
+        std::vector<Addr> stale_code_pages_;
+
+        sparta::Counter code_page_invalidations_;
+
+        void invalidateStaleCodePages_();
+
+        void clearCodePages_();
+
+        // Translations flushed by sfence.vma since the last block lookup
+        struct TranslationFlush
+        {
+            std::optional<Addr> vaddr;
+            std::optional<uint32_t> asid;
+        };
+
+        std::vector<TranslationFlush> translation_flushes_;
+
+        sparta::Counter translated_block_invalidations_;
+
+        void invalidateTranslatedBlocks_();
+
+        // Mask of the page offset of the largest page size of an MMU mode
+        static Addr getMaxPageOffsetMask_(const MMUMode mode);
+
+        // Small IDs of the block contexts, so block lookups do not compare whole contexts
+        BlockContext block_context_;
+        uint32_t block_context_id_ = 0;
+        std::map<BlockContext, uint32_t> block_context_ids_;
+        std::vector<BlockContext> block_contexts_;
+
+        sparta::Counter basic_blocks_executed_;
+        sparta::Counter basic_blocks_created_;
+        sparta::Counter basic_blocks_evicted_;
+
+        // Macro-op fusion in cached basic blocks
+        const bool enable_fusion_;
+        sparta::Counter fused_inst_pairs_;
+
+        // Tier thresholds and block cache capacity
+        const uint32_t block_threshold_;
+        const uint32_t block_cache_capacity_;
+
+        // Number of times each block that is not cached yet has been entered
+        std::unordered_map<BlockKey, uint32_t, BlockKeyHash> block_entries_;
+
+        // Instructions retired by each execution tier. Retired instructions are attributed to the
+        // current tier whenever the tier changes.
+        sparta::Counter interpreted_insts_;
+        sparta::Counter block_insts_;
+        sparta::StatisticDef interpreted_fraction_;
+        sparta::StatisticDef block_fraction_;
+
+        sparta::Counter* tier_insts_ = &interpreted_insts_;
+        uint64_t tier_start_inst_count_ = 0;
+
+        void switchTier_(sparta::Counter* tier_insts);
+
+        void updateTierInsts_();
+
+        // Instruction count events, sorted by instruction count
+        std::multimap<uint64_t, std::function<void()>> inst_count_events_;
+        uint64_t next_inst_count_event_ = std::numeric_limits<uint64_t>::max();
+
+        void handleInstCountEvents_();
+
+        // Add a decoded instruction to the basic block being recorded
+        void recordInst_(const Addr pc, const Addr paddr, const AtlasInstPtr & inst);
+
+        void finalizeRecordingBlock_();
+
+        // Free the coldest blocks when the block cache is full
+        void evictColdBlocks_();
+
+        // Returns the ActionGroup to execute for the current PC, either a cached basic block or
+        // the Fetch ActionGroup
+        ActionGroup* lookupBlock_();
+
+        std::function<void()> startup_handler_;
+
+        // Set by the instruction count event at the end of a quantum
+        bool quantum_expired_ = false;
+        bool hart_stopped_ = false;
+
         void advanceSim_();
+
+        // Run until simulation stops or the quantum expires, returns false once stopped
+        bool runHart_();
+
+        template <bool BLOCK_EXECUTION, bool THREADED_DISPATCH> bool run_();
     };
 } // namespace atlas
@@ -45,11 +45,13 @@ namespace atlas
 
 #include "core/Exception.hpp"
 
+// Traps redirect the executing ActionGroup to the Exception unit without unwinding, so they can
+// only be raised from an Action handler (the macros return from the handler)
 #define TRAP_IMPL(cause)                                                                           \
     {                                                                                              \
         auto exception_unit = state->getExceptionUnit();                                           \
         exception_unit->setUnhandledException(cause);                                              \
-        throw ActionException(exception_unit->getActionGroup());                                   \
+        return state->redirectActionGroup(exception_unit->getActionGroup());                       \
     }
 
 #define THROW_MISALIGNED_FETCH TRAP_IMPL(FaultCause::INST_ADDR_MISALIGNED)
@@ -90,7 +90,7 @@ namespace atlas
         template <typename XLEN> void vsetVTYPE(AtlasState* state, XLEN vtype)
         {
             WRITE_CSR_REG<XLEN>(state, VTYPE, vtype);
-            const size_t vlmul = READ_CSR_FIELD<XLEN>(state, VTYPE, "vlmul");
+            const size_t vlmul = READ_CSR_FIELD<XLEN, CSR_FIELDS::VTYPE::vlmul>(state);
 
             static const size_t lmul_table[8] = {
                 8,  // 000
@@ -106,9 +106,9 @@ namespace atlas
             const size_t lmul = lmul_table[vlmul & 0b111];
             sparta_assert(lmul, "Invalid vtype VLMUL encoding.");
             setLMUL(lmul);
-            setSEW(8u << READ_CSR_FIELD<XLEN>(state, VTYPE, "vsew"));
-            setVTA(READ_CSR_FIELD<XLEN>(state, VTYPE, "vta"));
-            setVMA(READ_CSR_FIELD<XLEN>(state, VTYPE, "vma"));
+            setSEW(8u << READ_CSR_FIELD<XLEN, CSR_FIELDS::VTYPE::vsew>(state));
+            setVTA(READ_CSR_FIELD<XLEN, CSR_FIELDS::VTYPE::vta>(state));
+            setVMA(READ_CSR_FIELD<XLEN, CSR_FIELDS::VTYPE::vma>(state));
         }
 
       private:
@@ -4,6 +4,8 @@
 #include "include/ActionTags.hpp"
 #include "include/AtlasUtils.hpp"
 
+#include <atomic>
+
 namespace atlas
 {
     template <typename T> struct MaxFunctor
@@ -319,20 +321,44 @@ namespace atlas
         const XLEN paddr = inst->getTranslationState()->getResult().getPAddr();
         inst->getTranslationState()->popResult();
 
-        XLEN rd_val = 0;
-        if constexpr (sizeof(XLEN) > sizeof(SIZE))
+        auto extend = [](const SIZE mem_val) -> XLEN
+        {
+            if constexpr (sizeof(XLEN) > sizeof(SIZE))
+            {
+                return signExtend<SIZE, XLEN>(mem_val);
+            }
+            else
+            {
+                return mem_val;
+            }
+        };
+
+        // Must read the RS2 value before writing the Rd (might be the
+        // same register!)
+        const XLEN rs2_val = inst->getRs2Reg()->dmiRead<uint64_t>();
+
+        // Harts running on other host threads may access the same memory, so update it with an
+        // atomic host operation when possible
+        uint8_t* host_ptr = state->getHostMemory(paddr, sizeof(SIZE));
+        if (host_ptr && ((paddr % sizeof(SIZE)) == 0))
         {
-            rd_val = signExtend<SIZE, XLEN>(state->readMemory<SIZE>(paddr));
+            std::atomic_ref<SIZE> mem_val(*reinterpret_cast<SIZE*>(host_ptr));
+            SIZE old_val = mem_val.load(std::memory_order_relaxed);
+            XLEN rd_val = 0;
+            do
+            {
+                rd_val = extend(old_val);
+            } while (!mem_val.compare_exchange_weak(old_val,
+                                                    static_cast<SIZE>(OP()(rd_val, rs2_val))));
+            state->snoopStore(paddr, sizeof(SIZE));
+            inst->getRdReg()->write(rd_val);
         }
         else
         {
-            rd_val = state->readMemory<SIZE>(paddr);
+            const XLEN rd_val = extend(state->readMemory<SIZE>(paddr));
+            inst->getRdReg()->write(rd_val);
+            state->writeMemory<SIZE>(paddr, OP()(rd_val, rs2_val));
         }
-        // Must read the RS2 value before writing the Rd (might be the
-        // same register!)
-        const XLEN rs2_val = inst->getRs2Reg()->dmiRead<uint64_t>();
-        inst->getRdReg()->write(rd_val);
-        state->writeMemory<SIZE>(paddr, OP()(rd_val, rs2_val));
         return ++action_it;
     }
 
@@ -342,13 +368,15 @@ namespace atlas
         const AtlasInstPtr & inst = state->getCurrentInst();
         auto xlation_state = inst->getTranslationState();
 
-        // Make the reservation
+        // Make the reservation, before reading memory so a store by another hart in between
+        // clears it
         state->getReservation() = xlation_state->getResult().getVAddr();
+        const uint64_t paddr = xlation_state->getResult().getPAddr();
+        state->getReservationTable()->reserve(state->getHartId(), paddr);
 
         // Get the memory
-        const uint64_t paddr = xlation_state->getResult().getPAddr();
         xlation_state->popResult();
-        const XLEN rd_val = state->readMemory<SIZE>(paddr);
+        const SIZE rd_val = state->readMemory<SIZE>(paddr);
         if constexpr (sizeof(XLEN) > sizeof(SIZE))
         {
             inst->getRdReg()->write(signExtend<SIZE, XLEN>(rd_val));
@@ -368,16 +396,25 @@ namespace atlas
         auto xlation_state = inst->getTranslationState();
 
         XLEN sc_bad = 1; // assume bad
+        ReservationTable* reservation_table = state->getReservationTable();
         if (auto & resv = state->getReservation(); resv.isValid())
         {
+            // A store by another hart since the LR clears the reservation in the table. The table
+            // is locked while checking the reservation and storing, so a store by a hart running
+            // on another host thread can not clear it in between.
+            const uint64_t paddr = xlation_state->getResult().getPAddr();
             if (resv == xlation_state->getResult().getVAddr())
             {
-                const uint64_t paddr = xlation_state->getResult().getPAddr();
                 const uint64_t rs2_val = inst->getRs2Reg()->dmiRead<uint64_t>();
-                state->writeMemory<SIZE>(paddr, rs2_val);
-                sc_bad = 0;
+                if (reservation_table->storeConditional(
+                        state->getHartId(), paddr, sizeof(SIZE),
+                        [state, paddr, rs2_val]() { state->writeMemory<SIZE>(paddr, rs2_val); }))
+                {
+                    sc_bad = 0;
+                }
             }
             resv.clearValid();
+            reservation_table->clear(state->getHartId());
         }
         xlation_state->popResult();
         inst->getRdReg()->dmiWrite<XLEN>(sc_bad);
@@ -73,37 +73,37 @@ namespace atlas
             // suffice.
 
             // FFLAGS
-            WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "NX",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::nx>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_inexact) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "UF",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::uf>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_underflow) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "OF",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::of>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_overflow) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "DZ",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::dz>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_infinite) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FFLAGS, "NV",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::nv>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_invalid) != 0));
 
             // FCSR
-            WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "NX",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::nx>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_inexact) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "UF",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::uf>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_underflow) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "OF",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::of>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_overflow) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "DZ",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::dz>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_infinite) != 0));
-            WRITE_CSR_FIELD<XLEN>(
-                state, FCSR, "NV",
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::nv>(
+                state,
                 static_cast<uint64_t>((softfloat_exceptionFlags & softfloat_flag_invalid) != 0));
         }
 
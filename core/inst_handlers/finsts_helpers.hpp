@@ -18,34 +18,33 @@ namespace atlas
         XLEN mask = 0;
         XLEN value = 0;
 
-        auto updateBitField =
-            [&mask, &value](uint32_t csr_num, const char* field_name, exceptionFlag_t flag)
+        // Field descriptors are passed by value only to deduce their type
+        auto updateBitField = [&mask, &value](auto field, exceptionFlag_t flag)
         {
-            const auto & csr_bit_range = getCsrBitRange<XLEN>(csr_num, field_name);
-            const auto lsb = csr_bit_range.first;
-            const auto msb = csr_bit_range.second;
+            using FIELD = decltype(field);
+            constexpr auto lsb = getCsrFieldLowBit<XLEN, FIELD>();
             value |= static_cast<XLEN>((softfloat_exceptionFlags & flag) != 0) << lsb;
-            mask |= ((XLEN{1} << (msb - lsb + 1)) - 1) << lsb;
+            mask |= getCsrFieldMask<XLEN, FIELD>();
         };
 
         // FFLAGS
         auto fflags = READ_CSR_REG<XLEN>(state, FFLAGS);
-        updateBitField(FFLAGS, "NX", softfloat_flag_inexact);
-        updateBitField(FFLAGS, "UF", softfloat_flag_underflow);
-        updateBitField(FFLAGS, "OF", softfloat_flag_overflow);
-        updateBitField(FFLAGS, "DZ", softfloat_flag_infinite);
-        updateBitField(FFLAGS, "NV", softfloat_flag_invalid);
+        updateBitField(CSR_FIELDS::FFLAGS::nx{}, softfloat_flag_inexact);
+        updateBitField(CSR_FIELDS::FFLAGS::uf{}, softfloat_flag_underflow);
+        updateBitField(CSR_FIELDS::FFLAGS::of{}, softfloat_flag_overflow);
+        updateBitField(CSR_FIELDS::FFLAGS::dz{}, softfloat_flag_infinite);
+        updateBitField(CSR_FIELDS::FFLAGS::nv{}, softfloat_flag_invalid);
         WRITE_CSR_REG<XLEN>(state, FFLAGS, (fflags & ~mask) | value);
 
         mask = 0;
         value = 0;
         // FCSR
         auto fcsr = READ_CSR_REG<XLEN>(state, FCSR);
-        updateBitField(FCSR, "NX", softfloat_flag_inexact);
-        updateBitField(FCSR, "UF", softfloat_flag_underflow);
-        updateBitField(FCSR, "OF", softfloat_flag_overflow);
-        updateBitField(FCSR, "DZ", softfloat_flag_infinite);
-        updateBitField(FCSR, "NV", softfloat_flag_invalid);
+        updateBitField(CSR_FIELDS::FCSR::nx{}, softfloat_flag_inexact);
+        updateBitField(CSR_FIELDS::FCSR::uf{}, softfloat_flag_underflow);
+        updateBitField(CSR_FIELDS::FCSR::of{}, softfloat_flag_overflow);
+        updateBitField(CSR_FIELDS::FCSR::dz{}, softfloat_flag_infinite);
+        updateBitField(CSR_FIELDS::FCSR::nv{}, softfloat_flag_invalid);
         WRITE_CSR_REG<XLEN>(state, FCSR, (fcsr & ~mask) | value);
     }
 
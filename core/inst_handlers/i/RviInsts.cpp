@@ -5,9 +5,12 @@
 #include "core/ActionGroup.hpp"
 #include "core/AtlasState.hpp"
 #include "core/AtlasInst.hpp"
+#include "core/Fetch.hpp"
+#include "core/translate/Translate.hpp"
 #include "system/AtlasSystem.hpp"
 
 #include <functional>
+#include <optional>
 
 namespace atlas
 {
@@ -609,6 +612,27 @@ namespace atlas
         const uint64_t rs1_val = READ_INT_REG<XLEN>(state, inst->getRs1());
         const XLEN imm = inst->getImmediate();
         const XLEN vaddr = rs1_val + imm;
+
+        // On a soft TLB hit, skip the translate Actions that follow this one
+        if (state->isFastCore())
+        {
+            Translate* translate_unit = state->getTranslateUnit();
+            const Translate::SoftTlbEntry* entry =
+                inst->isStoreType()
+                    ? translate_unit->lookupSoftTlb<Translate::AccessType::STORE>(vaddr,
+                                                                                  sizeof(SIZE))
+                    : translate_unit->lookupSoftTlb<Translate::AccessType::LOAD>(vaddr,
+                                                                                 sizeof(SIZE));
+            if (entry)
+            {
+                const Addr page_offset = vaddr - entry->vpage;
+                inst->getTranslationState()->setResult(vaddr, entry->ppage + page_offset,
+                                                       sizeof(SIZE),
+                                                       entry->host_page + page_offset);
+                return Translate::skipDataTranslate(action_it);
+            }
+        }
+
         inst->getTranslationState()->makeRequest(vaddr, sizeof(SIZE));
         return ++action_it;
     }
@@ -617,16 +641,26 @@ namespace atlas
     Action::ItrType RviInsts::loadHandler_(atlas::AtlasState* state, Action::ItrType action_it)
     {
         const AtlasInstPtr & inst = state->getCurrentInst();
-        const uint64_t paddr = inst->getTranslationState()->getResult().getPAddr();
+        const auto & result = inst->getTranslationState()->getResult();
+        SIZE value;
+        if (result.getHostPtr())
+        {
+            std::memcpy(&value, result.getHostPtr(), sizeof(SIZE));
+        }
+        else
+        {
+            value = state->readMemory<SIZE>(result.getPAddr());
+        }
         inst->getTranslationState()->popResult();
+
         if constexpr (SIGN_EXTEND)
         {
-            const XLEN rd_val = signExtend<SIZE, XLEN>(state->readMemory<SIZE>(paddr));
+            const XLEN rd_val = signExtend<SIZE, XLEN>(value);
             WRITE_INT_REG<XLEN>(state, inst->getRd(), rd_val);
         }
         else
         {
-            const XLEN rd_val = state->readMemory<SIZE>(paddr);
+            const XLEN rd_val = value;
             WRITE_INT_REG<XLEN>(state, inst->getRd(), rd_val);
         }
         return ++action_it;
@@ -637,9 +671,18 @@ namespace atlas
     {
         const AtlasInstPtr & inst = state->getCurrentInst();
         const uint64_t rs2_val = READ_INT_REG<XLEN>(state, inst->getRs2());
-        const uint64_t paddr = inst->getTranslationState()->getResult().getPAddr();
+        const auto & result = inst->getTranslationState()->getResult();
+        if (result.getHostPtr())
+        {
+            const SIZE value = rs2_val;
+            std::memcpy(result.getHostPtr(), &value, sizeof(SIZE));
+            state->snoopStore(result.getPAddr(), sizeof(SIZE));
+        }
+        else
+        {
+            state->writeMemory<SIZE>(result.getPAddr(), rs2_val);
+        }
         inst->getTranslationState()->popResult();
-        state->writeMemory<SIZE>(paddr, rs2_val);
         return ++action_it;
     }
 
@@ -904,16 +947,16 @@ namespace atlas
             state->setNextPc(READ_CSR_REG<XLEN>(state, MEPC) & state->getPcAlignmentMask());
 
             // Get the previous privilege mode from the MPP field of MSTATUS
-            prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, MSTATUS, "mpp");
+            prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpp>(state);
 
             // Get the previous virtual mode from the MPV field of MSTATUS
             if constexpr (std::is_same_v<XLEN, RV64>)
             {
-                prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, MSTATUS, "mpv");
+                prev_virt_mode = (bool)READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpv>(state);
             }
             else
             {
-                prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, MSTATUSH, "mpv");
+                prev_virt_mode = (bool)READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUSH::mpv>(state);
             }
 
             // If the mret instruction changes the privilege mode to a mode less privileged
@@ -922,33 +965,33 @@ namespace atlas
             {
                 // TODO: Will need to update the load/store translation mode when translation is
                 // supported
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mprv", (XLEN)0);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mprv>(state, (XLEN)0);
             }
 
             // Set MIE = MPIE and reset MPIE
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mie",
-                                  READ_CSR_FIELD<XLEN>(state, MSTATUS, "mpie"));
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpie", (XLEN)1);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mie>(
+                state, READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpie>(state));
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpie>(state, (XLEN)1);
 
             // Reset MPP
             // TODO: Check if User mode is available
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpp", (XLEN)PrivMode::USER);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpp>(state, (XLEN)PrivMode::USER);
 
             // Reset MPV
             if constexpr (std::is_same_v<XLEN, RV64>)
             {
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mpv", 0);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpv>(state, 0);
             }
             else
             {
-                WRITE_CSR_FIELD<XLEN>(state, MSTATUSH, "mpv", 0);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUSH::mpv>(state, 0);
             }
         }
         else
         {
             // When TSR=1, attempts to execute SRET in S-mode will
             // raise an illegal instruction exception
-            const uint32_t tsr_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "tsr");
+            const uint32_t tsr_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::tsr>(state);
             if ((state->getPrivMode() == PrivMode::SUPERVISOR) && tsr_val)
             {
                 THROW_ILLEGAL_INST;
@@ -958,26 +1001,26 @@ namespace atlas
             state->setNextPc(READ_CSR_REG<XLEN>(state, SEPC) & state->getPcAlignmentMask());
 
             // Get the previous privilege mode from the SPP field of MSTATUS
-            prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN>(state, MSTATUS, "spp");
+            prev_priv_mode = (PrivMode)READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::spp>(state);
 
             if (state->hasHypervisor())
             {
-                prev_virt_mode = (bool)READ_CSR_FIELD<XLEN>(state, HSTATUS, "spv");
-                WRITE_CSR_FIELD<XLEN>(state, HSTATUS, "spv", (XLEN)0);
+                prev_virt_mode = (bool)READ_CSR_FIELD<XLEN, CSR_FIELDS::HSTATUS::spv>(state);
+                WRITE_CSR_FIELD<XLEN, CSR_FIELDS::HSTATUS::spv>(state, (XLEN)0);
             }
 
             // Reset the MPRV bit
             // TODO: Will need to update the load/store translation mode when translation is
             // supported
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mprv", (XLEN)0);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mprv>(state, (XLEN)0);
 
             // Set SIE = MSTATUS[SPIE] and reset SPIE
-            WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "sie",
-                                  READ_CSR_FIELD<XLEN>(state, MSTATUS, "spie"));
-            WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "spie", (XLEN)1);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::sie>(
+                state, READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::spie>(state));
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::spie>(state, (XLEN)1);
 
             // Reset MPP
-            WRITE_CSR_FIELD<XLEN>(state, SSTATUS, "spp", (XLEN)PrivMode::USER);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::spp>(state, (XLEN)PrivMode::USER);
         }
 
         // TODO: Update MSTATUSH
@@ -1080,12 +1123,31 @@ namespace atlas
         // END OF SPIKE CODE
         ///////////////////////////////////////////////////////////////////////
 
-        const uint32_t tvm_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "tvm");
+        const uint32_t tvm_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::tvm>(state);
         if ((state->getPrivMode() == PrivMode::SUPERVISOR) && tvm_val)
         {
             THROW_ILLEGAL_INST;
         }
 
+        // rs1 selects the virtual address and rs2 the address space to flush, x0 means all
+        const AtlasInstPtr & inst = state->getCurrentInst();
+        std::optional<Addr> vaddr;
+        std::optional<uint32_t> asid;
+        if (inst->hasRs1() && (inst->getRs1() != 0))
+        {
+            vaddr = READ_INT_REG<XLEN>(state, inst->getRs1());
+        }
+        if (inst->hasRs2() && (inst->getRs2() != 0))
+        {
+            asid = READ_INT_REG<XLEN>(state, inst->getRs2());
+        }
+        state->getTranslateUnit()->flushTlb(vaddr, asid);
+
+        // Page table entries may have changed, cached translations and the basic blocks fetched
+        // through the flushed translations are no longer valid
+        state->getTranslateUnit()->flushSoftTlb();
+        state->getFetchUnit()->invalidateTranslatedBlocks(vaddr, asid);
+
         return ++action_it;
     }
 
@@ -1110,7 +1172,7 @@ namespace atlas
         // END OF SPIKE CODE
         ///////////////////////////////////////////////////////////////////////
 
-        const uint32_t tw_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "tw");
+        const uint32_t tw_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::tw>(state);
         if (tw_val)
         {
             THROW_ILLEGAL_INST;
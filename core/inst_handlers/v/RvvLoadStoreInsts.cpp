@@ -2,8 +2,12 @@
 #include "core/AtlasState.hpp"
 #include "core/ActionGroup.hpp"
 #include "core/VecElements.hpp"
+#include "core/translate/Translate.hpp"
 #include "include/ActionTags.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace atlas
 {
     template <typename XLEN>
@@ -220,6 +224,12 @@ namespace atlas
         Addr stride;
         if constexpr (addrMode == AddressingMode::UNIT)
         {
+            // Unmasked accesses with an element aligned base address are translated in page
+            // sized chunks, masked and misaligned accesses are translated one element at a time
+            if (inst->getVM() && ((rs1_val % eewb) == 0))
+            {
+                return unitStrideComputeAddress_<XLEN>(state, action_it, rs1_val, eewb);
+            }
             stride = eewb;
         }
         else if constexpr (addrMode == AddressingMode::STRIDED)
@@ -246,6 +256,73 @@ namespace atlas
         return ++action_it;
     }
 
+    template <typename XLEN>
+    Action::ItrType RvvLoadStoreInsts::unitStrideComputeAddress_(atlas::AtlasState* state,
+                                                                 Action::ItrType action_it,
+                                                                 const XLEN base_addr,
+                                                                 const size_t eewb)
+    {
+        const AtlasInstPtr inst = state->getCurrentInst();
+        const VectorConfig* config = state->getVectorConfig();
+        AtlasTranslationState* translation_state = inst->getTranslationState();
+        const size_t vstart = config->getVSTART();
+        const size_t vl = config->getVL();
+        if (vstart >= vl)
+        {
+            // Nothing to access, skip the translate Actions
+            return Translate::skipDataTranslate(action_it);
+        }
+
+        // A register group is at most 8 * VLEN/8 = 2048 bytes, so the access is split into at
+        // most two chunks at the page boundary. Elements are aligned so none crosses a chunk.
+        constexpr Addr MIN_PAGE_SIZE = Translate::SOFT_TLB_PAGE_SIZE;
+        const XLEN vaddr = base_addr + vstart * eewb;
+        const size_t size = (vl - vstart) * eewb;
+        const size_t first_size = std::min<size_t>(size, MIN_PAGE_SIZE - (vaddr % MIN_PAGE_SIZE));
+        const uint32_t num_chunks = (first_size < size) ? 2 : 1;
+        const std::array<XLEN, 2> chunk_vaddrs{vaddr, XLEN(vaddr + first_size)};
+        const std::array<size_t, 2> chunk_sizes{first_size, size - first_size};
+
+        // If every chunk hits in the soft TLB, skip the translate Actions that follow this one
+        if (state->isFastCore())
+        {
+            Translate* translate_unit = state->getTranslateUnit();
+            std::array<const Translate::SoftTlbEntry*, 2> entries{nullptr, nullptr};
+            bool all_hit = true;
+            for (uint32_t i = 0; all_hit && (i < num_chunks); ++i)
+            {
+                entries[i] =
+                    inst->isStoreType()
+                        ? translate_unit->lookupSoftTlb<Translate::AccessType::STORE>(
+                              chunk_vaddrs[i], chunk_sizes[i])
+                        : translate_unit->lookupSoftTlb<Translate::AccessType::LOAD>(
+                              chunk_vaddrs[i], chunk_sizes[i]);
+                all_hit = (entries[i] != nullptr);
+            }
+
+            if (all_hit)
+            {
+                // Results are consumed from the last one set, set the first chunk last
+                for (uint32_t i = num_chunks; i-- > 0;)
+                {
+                    const Addr page_offset = chunk_vaddrs[i] - entries[i]->vpage;
+                    translation_state->setResult(chunk_vaddrs[i], entries[i]->ppage + page_offset,
+                                                 chunk_sizes[i],
+                                                 entries[i]->host_page + page_offset);
+                }
+                return Translate::skipDataTranslate(action_it);
+            }
+        }
+
+        // Requests are translated from the last one made, so the first chunk's result is
+        // consumed first
+        for (uint32_t i = 0; i < num_chunks; ++i)
+        {
+            translation_state->makeRequest(chunk_vaddrs[i], chunk_sizes[i]);
+        }
+        return ++action_it;
+    }
+
     template <typename XLEN, size_t elemWidth, RvvLoadStoreInsts::AddressingMode addrMode>
     Action::ItrType RvvLoadStoreInsts::vlseIdxComputeAddressHandler_(atlas::AtlasState* state,
                                                                      Action::ItrType action_it)
@@ -288,35 +365,76 @@ namespace atlas
         Elements<Element<elemWidth>, false> elems{state, state->getVectorConfig(),
                                                   load ? inst->getRd() : inst->getRs3()};
 
-        auto execute = [&]<typename Iterator>(const Iterator & begin, const Iterator & end)
+        VectorConfig* config = state->getVectorConfig();
+        AtlasTranslationState* translation_state = inst->getTranslationState();
+        using ValueType = UintType<elemWidth>;
+        constexpr size_t eewb = elemWidth / 8;
+
+        // Access the consecutive elements covered by the next translation result, starting at
+        // elem_idx. Returns the number of elements accessed.
+        auto execute = [&](const size_t elem_idx)
         {
-            for (auto iter = begin; iter != end; ++iter)
+            const auto & result = translation_state->getResult();
+            const size_t num_elems = std::max<size_t>(result.getSize() / eewb, 1);
+            const Addr paddr = result.getPAddr();
+            uint8_t* host_ptr = result.getHostPtr() ? result.getHostPtr()
+                                                    : state->getHostMemory(paddr, num_elems * eewb);
+            for (size_t i = 0; i < num_elems; ++i)
             {
+                auto elem = elems.getElement(elem_idx + i);
                 if constexpr (load)
                 {
-                    UintType<elemWidth> value = state->readMemory<UintType<elemWidth>>(
-                        inst->getTranslationState()->getResult().getPAddr());
-                    inst->getTranslationState()->popResult();
-                    elems.getElement(iter.getIndex()).setVal(value);
+                    ValueType value;
+                    if (host_ptr)
+                    {
+                        std::memcpy(&value, host_ptr + i * eewb, eewb);
+                    }
+                    else
+                    {
+                        value = state->readMemory<ValueType>(paddr + i * eewb);
+                    }
+                    elem.setVal(value);
                 }
                 else
                 {
-                    UintType<elemWidth> value = elems.getElement(iter.getIndex()).getVal();
-                    state->writeMemory<UintType<elemWidth>>(
-                        inst->getTranslationState()->getResult().getPAddr(), value);
-                    inst->getTranslationState()->popResult();
+                    const ValueType value = elem.getVal();
+                    if (host_ptr)
+                    {
+                        std::memcpy(host_ptr + i * eewb, &value, eewb);
+                    }
+                    else
+                    {
+                        state->writeMemory<ValueType>(paddr + i * eewb, value);
+                    }
                 }
             }
+            if constexpr (!load)
+            {
+                if (host_ptr)
+                {
+                    state->snoopStore(paddr, num_elems * eewb);
+                }
+            }
+            translation_state->popResult();
+            return num_elems;
         };
 
         if (inst->getVM()) // unmasked
         {
-            execute(elems.begin(), elems.end());
+            // Unit-stride results cover a whole chunk of elements, the others a single element
+            for (size_t elem_idx = config->getVSTART(); elem_idx < config->getVL();)
+            {
+                elem_idx += execute(elem_idx);
+            }
         }
         else // masked
         {
-            const MaskElements mask_elems{state, state->getVectorConfig(), atlas::V0};
-            execute(mask_elems.maskBitIterBegin(), mask_elems.maskBitIterEnd());
+            const MaskElements mask_elems{state, config, atlas::V0};
+            for (auto mask_iter = mask_elems.maskBitIterBegin();
+                 mask_iter != mask_elems.maskBitIterEnd(); ++mask_iter)
+            {
+                execute(mask_iter.getIndex());
+            }
         }
 
         return ++action_it;
@@ -34,6 +34,11 @@ namespace atlas
         template <typename XLEN, size_t elemWidth, AddressingMode addrMode>
         Action::ItrType vlseComputeAddressHandler_(atlas::AtlasState* state,
                                                    Action::ItrType action_it);
+        // Translate an unmasked unit-stride access in at most two page sized chunks
+        template <typename XLEN>
+        static Action::ItrType unitStrideComputeAddress_(atlas::AtlasState* state,
+                                                         Action::ItrType action_it,
+                                                         const XLEN base_addr, const size_t eewb);
         template <typename XLEN, size_t elemWidth, AddressingMode addrMode>
         Action::ItrType vlseIdxComputeAddressHandler_(atlas::AtlasState* state,
                                                       Action::ItrType action_it);
@@ -6,6 +6,7 @@
 #include "core/AtlasInst.hpp"
 #include "core/Exception.hpp"
 #include "core/Trap.hpp"
+#include "core/translate/Translate.hpp"
 
 extern "C"
 {
@@ -83,6 +84,12 @@ namespace atlas
             MISA,
             atlas::Action::createAction<&RvzicsrInsts::misaUpdateHandler_<XLEN>, RvzicsrInsts>(
                 nullptr, "misaUpdate"));
+
+        // Machine Configuration
+        csrUpdate_actions.emplace(
+            MENVCFG,
+            atlas::Action::createAction<&RvzicsrInsts::menvcfgUpdateHandler_<XLEN>, RvzicsrInsts>(
+                nullptr, "menvcfgUpdate"));
     }
 
     template void RvzicsrInsts::getCsrUpdateActions<RV32>(Execute::CsrUpdateActionsMap &);
@@ -303,23 +310,23 @@ namespace atlas
                                                      Action::ItrType action_it)
     {
         // FFLAGS
-        const XLEN nx_val = READ_CSR_FIELD<XLEN>(state, FCSR, "NX");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "NX", nx_val);
+        const XLEN nx_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::nx>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::nx>(state, nx_val);
 
-        const XLEN uf_val = READ_CSR_FIELD<XLEN>(state, FCSR, "UF");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "UF", uf_val);
+        const XLEN uf_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::uf>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::uf>(state, uf_val);
 
-        const XLEN of_val = READ_CSR_FIELD<XLEN>(state, FCSR, "OF");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "OF", of_val);
+        const XLEN of_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::of>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::of>(state, of_val);
 
-        const XLEN dz_val = READ_CSR_FIELD<XLEN>(state, FCSR, "DZ");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "DZ", dz_val);
+        const XLEN dz_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::dz>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::dz>(state, dz_val);
 
-        const XLEN nv_val = READ_CSR_FIELD<XLEN>(state, FCSR, "NV");
-        WRITE_CSR_FIELD<XLEN>(state, FFLAGS, "NV", nv_val);
+        const XLEN nv_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::nv>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::nv>(state, nv_val);
 
         // FRM
-        const XLEN frm_val = READ_CSR_FIELD<XLEN>(state, FCSR, "frm");
+        const XLEN frm_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::frm>(state);
         WRITE_CSR_REG<XLEN>(state, FRM, frm_val);
 
         set_softfloat_excpetionFlags<XLEN>(state);
@@ -331,20 +338,20 @@ namespace atlas
     Action::ItrType RvzicsrInsts::fflagsUpdateHandler_(AtlasState* state, Action::ItrType action_it)
     {
         // FCSR
-        const XLEN nx_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "NX");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "NX", nx_val);
+        const XLEN nx_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::nx>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::nx>(state, nx_val);
 
-        const XLEN uf_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "UF");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "UF", uf_val);
+        const XLEN uf_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::uf>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::uf>(state, uf_val);
 
-        const XLEN of_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "OF");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "OF", of_val);
+        const XLEN of_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::of>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::of>(state, of_val);
 
-        const XLEN dz_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "DZ");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "DZ", dz_val);
+        const XLEN dz_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::dz>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::dz>(state, dz_val);
 
-        const XLEN nv_val = READ_CSR_FIELD<XLEN>(state, FFLAGS, "NV");
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "NV", nv_val);
+        const XLEN nv_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::FFLAGS::nv>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::nv>(state, nv_val);
 
         set_softfloat_excpetionFlags<XLEN>(state);
 
@@ -356,7 +363,7 @@ namespace atlas
     {
         // FCSR
         const XLEN frm_val = READ_CSR_REG<XLEN>(state, FRM);
-        WRITE_CSR_FIELD<XLEN>(state, FCSR, "frm", frm_val);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::FCSR::frm>(state, frm_val);
 
         return ++action_it;
     }
@@ -366,41 +373,41 @@ namespace atlas
                                                         Action::ItrType action_it)
     {
         // Update shared fields only
-        const XLEN sie_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "sie");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sie", sie_val);
+        const XLEN sie_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::sie>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::sie>(state, sie_val);
 
-        const XLEN spie_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "spie");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "spie", spie_val);
+        const XLEN spie_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::spie>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::spie>(state, spie_val);
 
-        const XLEN ube_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "ube");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "ube", ube_val);
+        const XLEN ube_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::ube>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::ube>(state, ube_val);
 
-        const XLEN spp_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "spp");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "spp", spp_val);
+        const XLEN spp_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::spp>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::spp>(state, spp_val);
 
-        const XLEN vs_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "vs");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "vs", vs_val);
+        const XLEN vs_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::vs>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::vs>(state, vs_val);
 
-        const XLEN fs_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "fs");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "fs", fs_val);
+        const XLEN fs_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::fs>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::fs>(state, fs_val);
 
-        const XLEN xs_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "xs");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "xs", xs_val);
+        const XLEN xs_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::xs>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::xs>(state, xs_val);
 
-        const XLEN sum_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "sum");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sum", sum_val);
+        const XLEN sum_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::sum>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::sum>(state, sum_val);
 
-        const XLEN mxr_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "mxr");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "mxr", mxr_val);
+        const XLEN mxr_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::mxr>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mxr>(state, mxr_val);
 
         if constexpr (std::is_same_v<XLEN, RV64>)
         {
-            const XLEN uxl_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "uxl");
-            WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "uxl", uxl_val);
+            const XLEN uxl_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::uxl>(state);
+            WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::uxl>(state, uxl_val);
         }
 
-        const XLEN sd_val = READ_CSR_FIELD<XLEN>(state, SSTATUS, "sd");
-        WRITE_CSR_FIELD<XLEN>(state, MSTATUS, "sd", sd_val);
+        const XLEN sd_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::SSTATUS::sd>(state);
+        WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::sd>(state, sd_val);
 
         return mstatusUpdateHandler_<XLEN>(state, action_it);
     }
@@ -423,7 +430,7 @@ namespace atlas
         WRITE_CSR_REG<XLEN>(state, SSTATUS, mstatus_val);
 
         // If FS is set to 0 (off), all floating point extensions are disabled
-        const uint32_t fs_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "fs");
+        const uint32_t fs_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::fs>(state);
         auto & inclusions = state->getMavisInclusions();
         if (fs_val == 0)
         {
@@ -432,8 +439,8 @@ namespace atlas
         }
         else
         {
-            const bool f_ext_enabled = READ_CSR_FIELD<XLEN>(state, MISA, "f") == 0x1;
-            const bool d_ext_enabled = READ_CSR_FIELD<XLEN>(state, MISA, "d") == 0x1;
+            const bool f_ext_enabled = READ_CSR_FIELD<XLEN, CSR_FIELDS::MISA::f>(state) == 0x1;
+            const bool d_ext_enabled = READ_CSR_FIELD<XLEN, CSR_FIELDS::MISA::d>(state) == 0x1;
             if (f_ext_enabled)
             {
                 inclusions.emplace("f");
@@ -472,7 +479,7 @@ namespace atlas
                 // misalignment exception. Check if the next PC is not 32-bit aligned.
                 if ((ext == 'c') && ((state->getNextPc() & 0x3) != 0))
                 {
-                    WRITE_CSR_FIELD<XLEN>(state, MISA, "c", 0x1);
+                    WRITE_CSR_FIELD<XLEN, CSR_FIELDS::MISA::c>(state, 0x1);
                 }
                 else
                 {
@@ -485,4 +492,13 @@ namespace atlas
 
         return ++action_it;
     }
+
+    template <typename XLEN>
+    Action::ItrType RvzicsrInsts::menvcfgUpdateHandler_(atlas::AtlasState* state,
+                                                        Action::ItrType action_it)
+    {
+        // ADUE controls whether page walks update the PTE A/D bits
+        state->getTranslateUnit()->updateTranslationContext<XLEN>(state);
+        return ++action_it;
+    }
 } // namespace atlas
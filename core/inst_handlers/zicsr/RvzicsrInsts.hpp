@@ -56,5 +56,7 @@ namespace atlas
         Action::ItrType mstatusUpdateHandler_(atlas::AtlasState* state, Action::ItrType action_it);
         template <typename XLEN>
         Action::ItrType misaUpdateHandler_(atlas::AtlasState* state, Action::ItrType action_it);
+        template <typename XLEN>
+        Action::ItrType menvcfgUpdateHandler_(atlas::AtlasState* state, Action::ItrType action_it);
     };
 } // namespace atlas
@@ -3,6 +3,7 @@
 #include "core/ActionGroup.hpp"
 #include "core/AtlasState.hpp"
 #include "core/AtlasInst.hpp"
+#include "core/Fetch.hpp"
 
 namespace atlas
 {
@@ -33,8 +34,8 @@ namespace atlas
     Action::ItrType RvzifenceiInsts::fence_iHandler_(atlas::AtlasState* state,
                                                      Action::ItrType action_it)
     {
-        // TODO: Flush any TLBs and instruction/block caches in the future
-        (void)state;
+        // Instruction memory may have been modified, cached basic blocks are no longer valid
+        state->getFetchUnit()->invalidateBlockCache();
 
         return ++action_it;
     }
@@ -5,6 +5,7 @@
 #include "sparta/memory/BlockingMemoryIFNode.hpp"
 #include "core/Trap.hpp"
 #include "include/AtlasTypes.hpp"
+#include "include/ByteVector.hpp"
 
 namespace atlas
 {
@@ -62,11 +63,11 @@ namespace atlas
           public:
             RegValue() = default;
 
-            RegValue(const std::vector<uint8_t> & value) : value_(value) {}
+            RegValue(const ByteVector & value) : value_(value) {}
 
             template <typename TYPE> RegValue(TYPE value) { setValue<TYPE>(value); }
 
-            void setValue(const std::vector<uint8_t> & value)
+            void setValue(const ByteVector & value)
             {
                 value_ = value;
             }
@@ -97,10 +98,10 @@ namespace atlas
 
             size_t size() const { return value_.size(); }
 
-            const std::vector<uint8_t> & getByteVector() const { return value_; }
+            const ByteVector & getByteVector() const { return value_; }
 
           private:
-            std::vector<uint8_t> value_;
+            ByteVector value_;
 
             friend std::ostream & operator<<(std::ostream & os, const RegValue & reg_value);
         };
@@ -232,10 +233,10 @@ namespace atlas
             mem_writes_.clear();
         }
 
-        std::vector<uint8_t> readRegister_(const sparta::Register* reg) const
+        ByteVector readRegister_(const sparta::Register* reg) const
         {
             const size_t num_bytes = reg->getNumBytes();
-            std::vector<uint8_t> value(num_bytes, 0);
+            ByteVector value(num_bytes);
             const uint32_t offset = 0;
             reg->peek(value.data(), num_bytes, offset);
             return value;
@@ -658,6 +658,9 @@ namespace atlas
                         ss >> val;
 
                         reg->dmiWrite(val);
+
+                        // The register may be satp, mstatus or menvcfg
+                        state->changeMMUMode();
                         sendAck_();
                         return true;
                     }
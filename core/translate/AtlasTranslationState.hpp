@@ -48,10 +48,11 @@ namespace atlas
           public:
             TranslationResult() = default;
 
-            TranslationResult(Addr vaddr, Addr paddr, size_t sz) :
+            TranslationResult(Addr vaddr, Addr paddr, size_t sz, uint8_t* host_ptr = nullptr) :
                 vaddr_(vaddr),
                 paddr_(paddr),
-                size_(sz)
+                size_(sz),
+                host_ptr_(host_ptr)
             {
             }
 
@@ -64,10 +65,14 @@ namespace atlas
 
             bool isValid() const { return size_ != 0; }
 
+            // Host pointer to the physical address, only set by a soft TLB hit
+            uint8_t* getHostPtr() const { return host_ptr_; }
+
           private:
             Addr vaddr_ = 0;
             Addr paddr_ = 0;
             size_t size_ = 0;
+            uint8_t* host_ptr_ = nullptr;
         };
 
         void makeRequest(const Addr vaddr, const size_t size)
@@ -92,10 +97,11 @@ namespace atlas
             --requests_cnt_;
         }
 
-        void setResult(const Addr vaddr, const Addr paddr, const size_t size)
+        void setResult(const Addr vaddr, const Addr paddr, const size_t size,
+                       uint8_t* host_ptr = nullptr)
         {
             sparta_assert(results_cnt_ < results_.size());
-            results_[results_cnt_++] = {vaddr, paddr, size};
+            results_[results_cnt_++] = {vaddr, paddr, size, host_ptr};
         }
 
         uint32_t getNumResults() const { return results_cnt_; }
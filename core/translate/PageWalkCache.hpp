@@ -0,0 +1,80 @@
+#pragma once
+
+#include "include/AtlasTypes.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <bit>
+#include <optional>
+#include <vector>
+
+namespace atlas
+{
+    // Direct mapped cache of non-leaf PTEs. An entry maps the part of a virtual address that is
+    // translated by the page table levels above a non-leaf PTE (the partial VPN) to the physical
+    // address of the next level page table, so a walk can start at the deepest cached level
+    // instead of at the root.
+    //
+    // Entries are tagged by MMU mode and root page table (satp.ppn), so switching address spaces
+    // does not require a flush.
+    class PageWalkCache
+    {
+      public:
+        PageWalkCache(const uint32_t num_entries) : entries_(num_entries)
+        {
+            sparta_assert(std::has_single_bit(num_entries),
+                          "Page walk cache size (" << num_entries << ") must be a power of 2");
+        }
+
+        // Returns the physical address of the next level page table
+        std::optional<Addr> lookup(const uint32_t level, const Addr partial_vpn, const MMUMode mode,
+                    const Addr root_paddr) const
+        {
+            const Entry & entry = getEntry_(level, partial_vpn);
+            if (entry.valid && (entry.level == level) && (entry.partial_vpn == partial_vpn)
+                && (entry.mode == mode) && (entry.root_paddr == root_paddr))
+            {
+                return entry.table_paddr;
+            }
+            return std::nullopt;
+        }
+
+        void insert(const uint32_t level, const Addr partial_vpn, const MMUMode mode,
+                    const Addr root_paddr, const Addr table_paddr)
+        {
+            getEntry_(level, partial_vpn) = {true, level, partial_vpn, mode, root_paddr,
+                                             table_paddr};
+        }
+
+        void flush()
+        {
+            for (auto & entry : entries_)
+            {
+                entry.valid = false;
+            }
+        }
+
+      private:
+        struct Entry
+        {
+            bool valid = false;
+            uint32_t level = 0;
+            Addr partial_vpn = 0;
+            MMUMode mode = MMUMode::INVALID;
+            Addr root_paddr = 0;
+            Addr table_paddr = 0;
+        };
+
+        std::vector<Entry> entries_;
+
+        Entry & getEntry_(const uint32_t level, const Addr partial_vpn)
+        {
+            return entries_[(partial_vpn + level) & (entries_.size() - 1)];
+        }
+
+        const Entry & getEntry_(const uint32_t level, const Addr partial_vpn) const
+        {
+            return entries_[(partial_vpn + level) & (entries_.size() - 1)];
+        }
+    };
+} // namespace atlas
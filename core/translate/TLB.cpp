@@ -0,0 +1,114 @@
+#include "core/translate/TLB.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <bit>
+
+namespace atlas
+{
+    TLB::TLB(sparta::StatisticSet* stats, const std::string & name, const uint32_t num_entries,
+             const uint32_t associativity) :
+        associativity_(associativity),
+        num_sets_((associativity > 0) ? (num_entries / associativity) : 0),
+        entries_(num_entries),
+        hits_(stats, name + "_hits", "Number of " + name + " hits", sparta::Counter::COUNT_NORMAL),
+        misses_(stats, name + "_misses", "Number of " + name + " misses",
+                sparta::Counter::COUNT_NORMAL),
+        flushes_(stats, name + "_flushes", "Number of sfence.vma " + name + " flushes",
+                 sparta::Counter::COUNT_NORMAL)
+    {
+        sparta_assert(associativity_ > 0, name << " associativity must be greater than 0");
+        sparta_assert((num_entries % associativity_) == 0,
+                      name << " size (" << num_entries << ") must be a multiple of the "
+                           << "associativity (" << associativity_ << ")");
+        sparta_assert(std::has_single_bit(num_sets_),
+                      name << " number of sets (" << num_sets_ << ") must be a power of 2");
+    }
+
+    TLB::Entry* TLB::lookup(const Addr vaddr, const MMUMode mode, const uint32_t asid,
+                            const uint32_t vmid)
+    {
+        uint64_t page_shifts = page_shifts_;
+        while (page_shifts)
+        {
+            const uint32_t page_shift = std::countr_zero(page_shifts);
+            page_shifts &= page_shifts - 1;
+
+            const Addr vpn = vaddr >> page_shift;
+            Entry* set = getSet_(vpn);
+            for (uint32_t way = 0; way < associativity_; ++way)
+            {
+                Entry & entry = set[way];
+                if (entry.valid && (entry.vpn == vpn) && (entry.page_shift == page_shift)
+                    && (entry.mode == mode) && (entry.global || (entry.asid == asid))
+                    && (entry.vmid == vmid))
+                {
+                    entry.last_use = ++use_count_;
+                    ++hits_;
+                    return &entry;
+                }
+            }
+        }
+
+        ++misses_;
+        return nullptr;
+    }
+
+    void TLB::insert(const Addr vaddr, const MMUMode mode, const uint32_t asid,
+                     const uint32_t vmid, const bool global, const Addr page_offset_mask,
+                     const uint32_t level, const uint64_t pte, const Addr pte_paddr)
+    {
+        const uint32_t page_shift = std::popcount(page_offset_mask);
+        const Addr vpn = vaddr >> page_shift;
+
+        // Replace an invalid entry or the least recently used one
+        Entry* set = getSet_(vpn);
+        Entry* victim = &set[0];
+        for (uint32_t way = 0; way < associativity_; ++way)
+        {
+            Entry & entry = set[way];
+            if (entry.valid == false)
+            {
+                victim = &entry;
+                break;
+            }
+            if (entry.last_use < victim->last_use)
+            {
+                victim = &entry;
+            }
+        }
+
+        *victim = {true, mode, asid, vmid, global, page_shift, vpn, level, pte, pte_paddr,
+                   ++use_count_};
+        page_shifts_ |= (uint64_t)1 << page_shift;
+    }
+
+    void TLB::flush(const std::optional<Addr> & vaddr, const std::optional<uint32_t> & asid)
+    {
+        ++flushes_;
+        if (!vaddr && !asid)
+        {
+            for (auto & entry : entries_)
+            {
+                entry.valid = false;
+            }
+            page_shifts_ = 0;
+            return;
+        }
+
+        for (auto & entry : entries_)
+        {
+            if (vaddr && (entry.contains(vaddr.value()) == false))
+            {
+                continue;
+            }
+
+            if (asid && (entry.global || (entry.asid != asid.value())))
+            {
+                continue;
+            }
+
+            entry.valid = false;
+        }
+    }
+} // namespace atlas
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "include/AtlasTypes.hpp"
+
+#include "sparta/statistics/Counter.hpp"
+#include "sparta/statistics/StatisticSet.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace atlas
+{
+    // Set associative TLB holding leaf PTEs. Entries are tagged by MMU mode, ASID and VMID (global
+    // pages match any ASID) and can map any page size supported by the MMU mode. Since a
+    // superpage is indexed by its own VPN, a lookup probes once for each page size that is
+    // currently cached.
+    //
+    // Only the translation is cached, permission checks are performed on the cached PTE by the
+    // Translate unit on every hit.
+    class TLB
+    {
+      public:
+        struct Entry
+        {
+            bool valid = false;
+            MMUMode mode = MMUMode::INVALID;
+            uint32_t asid = 0;
+            uint32_t vmid = 0;
+            bool global = false;
+
+            // Virtual page number, the virtual address shifted right by the page size
+            uint32_t page_shift = 0;
+            Addr vpn = 0;
+
+            // Page walk level and physical address of the leaf PTE
+            uint32_t level = 0;
+            uint64_t pte = 0;
+            Addr pte_paddr = 0;
+
+            // Last time the entry was used, for LRU replacement
+            uint64_t last_use = 0;
+
+            bool contains(const Addr vaddr) const
+            {
+                return valid && ((vaddr >> page_shift) == vpn);
+            }
+        };
+
+        TLB(sparta::StatisticSet* stats, const std::string & name, const uint32_t num_entries,
+            const uint32_t associativity);
+
+        // Returns the entry that translates vaddr in the given address space, or nullptr
+        Entry* lookup(const Addr vaddr, const MMUMode mode, const uint32_t asid,
+                      const uint32_t vmid);
+
+        // Cache a leaf PTE, replacing the least recently used entry of the set
+        void insert(const Addr vaddr, const MMUMode mode, const uint32_t asid, const uint32_t vmid,
+                    const bool global, const Addr page_offset_mask, const uint32_t level,
+                    const uint64_t pte, const Addr pte_paddr);
+
+        void invalidate(Entry* entry) { entry->valid = false; }
+
+        // Flush entries like sfence.vma: all entries, the entries that map vaddr, the non-global
+        // entries of an address space or the non-global entries that map vaddr in an address
+        // space
+        void flush(const std::optional<Addr> & vaddr = std::nullopt,
+                   const std::optional<uint32_t> & asid = std::nullopt);
+
+        uint32_t getNumEntries() const { return entries_.size(); }
+
+        uint32_t getAssociativity() const { return associativity_; }
+
+      private:
+        const uint32_t associativity_;
+        const uint32_t num_sets_;
+        std::vector<Entry> entries_;
+        uint64_t use_count_ = 0;
+
+        // Page sizes (as shifts) that have been cached since the last full flush
+        uint64_t page_shifts_ = 0;
+
+        Entry* getSet_(const Addr vpn)
+        {
+            return &entries_[(vpn & (num_sets_ - 1)) * associativity_];
+        }
+
+        sparta::Counter hits_;
+        sparta::Counter misses_;
+        sparta::Counter flushes_;
+    };
+} // namespace atlas
@@ -7,6 +7,7 @@
 #include "core/AtlasState.hpp"
 
 #include "include/ActionTags.hpp"
+#include "system/AtlasSystem.hpp"
 
 #include "sparta/utils/LogUtils.hpp"
 
@@ -14,9 +15,54 @@ namespace atlas
 {
 
     Translate::Translate(sparta::TreeNode* translate_node, const TranslateParameters* p) :
-        sparta::Unit(translate_node)
+        sparta::Unit(translate_node),
+        page_walks_(getStatisticSet(), "page_walks", "Number of page table walks",
+                    sparta::Counter::COUNT_NORMAL),
+        page_walk_pte_reads_(getStatisticSet(), "page_walk_pte_reads",
+                             "Number of PTEs read from memory by page table walks",
+                             sparta::Counter::COUNT_NORMAL),
+        page_walk_cache_hits_(getStatisticSet(), "page_walk_cache_hits",
+                              "Number of page table walks that started below the root",
+                              sparta::Counter::COUNT_NORMAL),
+        page_walk_cache_misses_(getStatisticSet(), "page_walk_cache_misses",
+                                "Number of page table walks that started at the root",
+                                sparta::Counter::COUNT_NORMAL),
+        pte_reads_per_walk_(getStatisticSet(), "pte_reads_per_walk",
+                            "Average number of PTEs read per page table walk", getStatisticSet(),
+                            "page_walk_pte_reads/page_walks", sparta::StatisticDef::VS_ABSOLUTE),
+        soft_tlb_hits_(getStatisticSet(), "soft_tlb_hits",
+                       "Number of loads and stores that hit in the soft TLB",
+                       sparta::Counter::COUNT_NORMAL),
+        soft_tlb_misses_(getStatisticSet(), "soft_tlb_misses",
+                         "Number of loads and stores that missed in the soft TLB",
+                         sparta::Counter::COUNT_NORMAL),
+        soft_tlb_flushes_(getStatisticSet(), "soft_tlb_flushes",
+                          "Number of times the soft TLB was flushed",
+                          sparta::Counter::COUNT_NORMAL),
+        soft_tlb_hit_rate_(getStatisticSet(), "soft_tlb_hit_rate", "Soft TLB hit rate",
+                           getStatisticSet(), "soft_tlb_hits/(soft_tlb_hits+soft_tlb_misses)",
+                           sparta::StatisticDef::VS_FRACTIONAL)
     {
-        (void)p;
+        if (p->enable_page_walk_cache)
+        {
+            page_walk_cache_ = std::make_unique<PageWalkCache>(p->page_walk_cache_num_entries);
+        }
+
+        if (p->enable_tlb)
+        {
+            if (p->split_tlb)
+            {
+                inst_tlb_ = std::make_unique<TLB>(getStatisticSet(), "itlb", p->tlb_num_entries,
+                                                  p->tlb_associativity);
+                data_tlb_ = std::make_unique<TLB>(getStatisticSet(), "dtlb", p->tlb_num_entries,
+                                                  p->tlb_associativity);
+            }
+            else
+            {
+                inst_tlb_ = std::make_unique<TLB>(getStatisticSet(), "tlb", p->tlb_num_entries,
+                                                  p->tlb_associativity);
+            }
+        }
 
         // Baremetal (translation disabled)
         {
@@ -119,6 +165,9 @@ namespace atlas
         sparta_assert(mode != MMUMode::INVALID);
         sparta_assert(ls_mode != MMUMode::INVALID);
 
+        // Cached translations may no longer be valid
+        flushSoftTlb();
+
         if constexpr (std::is_same_v<XLEN, RV64>)
         {
             inst_translate_action_group_.replaceAction(
@@ -145,9 +194,98 @@ namespace atlas
         }
     }
 
+    template <typename XLEN> void Translate::updateTranslationContext(AtlasState* state)
+    {
+        translation_context_ = makeTranslationContext_<XLEN>(state);
+    }
+
+    template <typename XLEN>
+    Translate::TranslationContext Translate::makeTranslationContext_(AtlasState* state)
+    {
+        TranslationContext context;
+
+        // Smallest page size is 4K for both RV32 and RV64
+        constexpr uint64_t PAGESHIFT = 12; // 4096
+        context.root_paddr = READ_CSR_FIELD<XLEN, CSR_FIELDS::SATP::ppn>(state) << PAGESHIFT;
+        context.asid = READ_CSR_FIELD<XLEN, CSR_FIELDS::SATP::asid>(state);
+        context.sum = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::sum>(state);
+        context.mxr = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mxr>(state);
+        context.adue = READ_CSR_FIELD<XLEN, CSR_FIELDS::MENVCFG::adue>(state);
+        context.priv_mode = state->getPrivMode();
+
+        // Same as AtlasState::changeMMUMode, so a change to MPRV or MPP is caught too
+        const uint32_t mprv_val = READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mprv>(state);
+        const PrivMode prev_priv_mode =
+            (PrivMode)READ_CSR_FIELD<XLEN, CSR_FIELDS::MSTATUS::mpp>(state);
+        context.ldst_priv_mode = (mprv_val == 1) ? prev_priv_mode : context.priv_mode;
+        return context;
+    }
+
+    void Translate::flushSoftTlb()
+    {
+        load_soft_tlb_.fill(SoftTlbEntry());
+        store_soft_tlb_.fill(SoftTlbEntry());
+        ++soft_tlb_flushes_;
+    }
+
+    void Translate::flushTlb(const std::optional<Addr> & vaddr,
+                             const std::optional<uint32_t> & asid)
+    {
+        if (inst_tlb_)
+        {
+            inst_tlb_->flush(vaddr, asid);
+        }
+        if (data_tlb_)
+        {
+            data_tlb_->flush(vaddr, asid);
+        }
+
+        // Non-leaf PTEs are not tagged by ASID, flush all of them
+        if (page_walk_cache_)
+        {
+            page_walk_cache_->flush();
+        }
+    }
+
+    template <Translate::AccessType TYPE>
+    void Translate::fillSoftTlb_(AtlasState* state,
+                                 const AtlasTranslationState::TranslationRequest & request,
+                                 const Addr paddr)
+    {
+        if constexpr (TYPE != AccessType::INSTRUCTION)
+        {
+            // The second half of a misaligned access is not in the same page
+            if (request.isMisaligned())
+            {
+                return;
+            }
+
+            constexpr Addr PAGE_MASK = ~(SOFT_TLB_PAGE_SIZE - 1);
+            const Addr ppage = paddr & PAGE_MASK;
+            uint8_t* host_page = state->getAtlasSystem()->getHostBlock(ppage);
+            if (host_page == nullptr)
+            {
+                return;
+            }
+
+            const Addr vpage = request.getVAddr() & PAGE_MASK;
+            auto & soft_tlb = (TYPE == AccessType::LOAD) ? load_soft_tlb_ : store_soft_tlb_;
+            soft_tlb[(vpage / SOFT_TLB_PAGE_SIZE) % SOFT_TLB_SIZE] = {vpage, ppage, host_page};
+        }
+        else
+        {
+            (void)state;
+            (void)request;
+            (void)paddr;
+        }
+    }
+
     template void Translate::changeMMUMode<RV32>(const MMUMode, const MMUMode);
     template void Translate::changeMMUMode<RV64>(const MMUMode, const MMUMode);
 
+    template void Translate::updateTranslationContext<RV32>(AtlasState*);
+    template void Translate::updateTranslationContext<RV64>(AtlasState*);
+
     template <typename XLEN, MMUMode MODE, Translate::AccessType TYPE>
     Action::ItrType Translate::translate_(AtlasState* state, Action::ItrType action_it)
     {
@@ -170,12 +308,19 @@ namespace atlas
                                : request.getVAddr();
 
         uint32_t level = translate_types::getNumPageWalkLevels<MODE>();
+        const TranslationContext & context = translation_context_;
+#ifndef NDEBUG
+        sparta_assert(context == makeTranslationContext_<XLEN>(state),
+                      "Stale translation context, AtlasState::changeMMUMode must be called after "
+                      "satp, mstatus, menvcfg or the privilege mode change");
+#endif
         const auto priv_mode =
-            (TYPE == AccessType::INSTRUCTION) ? state->getPrivMode() : state->getLdstPrivMode();
+            (TYPE == AccessType::INSTRUCTION) ? context.priv_mode : context.ldst_priv_mode;
 
         // See if translation is disable -- no level walks
         if (level == 0 || (priv_mode == PrivMode::MACHINE))
         {
+            fillSoftTlb_<TYPE>(state, request, vaddr);
             return setResult_<XLEN, MODE, TYPE>(translation_state, action_it, vaddr);
         }
 
@@ -183,9 +328,71 @@ namespace atlas
         const uint32_t width = std::is_same_v<XLEN, RV64> ? 16 : 8;
         ILOG("Translating " << HEX(vaddr, width));
 
+        // VMIDs are always 0 until the hypervisor extension is supported
+        TLB* tlb = getTLB_<TYPE>();
+        const uint32_t asid = context.asid;
+        const uint32_t vmid = 0;
+        if (tlb)
+        {
+            if (TLB::Entry* entry = tlb->lookup(vaddr, MODE, asid, vmid))
+            {
+                PageTableEntry<XLEN, MODE> pte(entry->pte);
+                DLOG("TLB hit: " << pte);
+
+                // A/D bits are only updated by a page walk, which reads the current PTE from
+                // memory instead of writing back the cached one
+                if (pte.isAccessable(TYPE == AccessType::STORE)
+                    && checkLeafPte_<XLEN, MODE, TYPE>(state, pte, entry->pte_paddr,
+                                                       entry->level, priv_mode))
+                {
+                    const uint32_t hit_level = entry->level;
+                    const Addr paddr = calcPAddr_<XLEN, MODE>(pte, hit_level, vaddr);
+                    fillSoftTlb_<TYPE>(state, request, paddr);
+                    return setResult_<XLEN, MODE, TYPE>(translation_state, action_it, paddr,
+                                                        hit_level);
+                }
+
+                // The cached PTE may be stale or need its A/D bits updated, walk the page table
+                // again
+                tlb->invalidate(entry);
+            }
+        }
+
         // Smallest page size is 4K for both RV32 and RV64
         constexpr uint64_t PAGESHIFT = 12; // 4096
-        uint64_t ppn = READ_CSR_FIELD<XLEN>(state, SATP, "ppn") << PAGESHIFT;
+        const uint64_t root_paddr = context.root_paddr;
+        uint64_t ppn = root_paddr;
+        ++page_walks_;
+
+        // Start at the deepest cached non-leaf PTE. Level 1 PTEs are always leaves.
+        if (page_walk_cache_)
+        {
+            bool pwc_hit = false;
+            for (uint32_t pwc_level = 2; pwc_level <= level; ++pwc_level)
+            {
+                const Addr partial_vpn = vaddr >> getPageShift_<MODE>(pwc_level);
+                const auto table_paddr =
+                    page_walk_cache_->lookup(pwc_level, partial_vpn, MODE, root_paddr);
+                if (table_paddr)
+                {
+                    DLOG("Page walk cache hit at level " << pwc_level);
+                    ppn = table_paddr.value();
+                    level = pwc_level - 1;
+                    pwc_hit = true;
+                    break;
+                }
+            }
+
+            if (pwc_hit)
+            {
+                ++page_walk_cache_hits_;
+            }
+            else
+            {
+                ++page_walk_cache_misses_;
+            }
+        }
+
         while (level > 0)
         {
             // Read PTE from memory
@@ -193,6 +400,7 @@ namespace atlas
             const auto & vpn_field = translate_types::getVpnField<MODE>(indexed_level);
             const uint64_t pte_paddr = ppn + vpn_field.calcPTEOffset(vaddr) * sizeof(XLEN);
             PageTableEntry<XLEN, MODE> pte = state->readMemory<XLEN>(pte_paddr);
+            ++page_walk_pte_reads_;
             DLOG_CODE_BLOCK(DLOG_OUTPUT("Level " << level << " Page Walk");
                             DLOG_OUTPUT("    Addr: " << HEX(pte_paddr, width));
                             DLOG_OUTPUT("     PTE: " << pte););
@@ -209,102 +417,35 @@ namespace atlas
             // If PTE is a leaf, perform address translation
             if (pte.isLeaf())
             {
-                const PageSize page_size = translate_types::getPageSize<MODE>(level);
-                DLOG("    Size: " << page_size);
-
-                // TODO: Check page alignment
-
-                // If page is a super page, unused PPN fields should be zero
-                if (page_size != PageSize::SIZE_4K)
-                {
-                    bool throw_page_fault = false;
-                    for (int32_t ppn_field_idx = indexed_level - 1; ppn_field_idx >= 0;
-                         --ppn_field_idx)
-                    {
-                        const XLEN ppn_field = pte.getPpnField(ppn_field_idx);
-                        if (ppn_field != 0)
-                        {
-                            DLOG("Translation FAILED! PPN field " << std::dec << ppn_field_idx
-                                                                  << " is not zero: 0x" << std::hex
-                                                                  << ppn_field);
-                            throw_page_fault = true;
-                        }
-                    }
-                    if (throw_page_fault)
-                    {
-                        break;
-                    }
-                }
-
-                // If the SUM bit is set, Supervisor mode software is allowed to access User mode
-                // pages
-                const uint32_t sum_val = READ_CSR_FIELD<XLEN>(state, MSTATUS, "sum");
-                if ((sum_val == 0) && (false == pte.isUserMode())
-                    && (priv_mode != PrivMode::SUPERVISOR))
-                {
-                    DLOG("Translation FAILED! Cannot access User mode PTE");
-                    break;
-                }
-
-                // Instruction (fetch) accesses must have execute permissions
-                if ((TYPE == AccessType::INSTRUCTION) && (false == pte.canExecute()))
-                {
-                    DLOG("Translation FAILED! PTE does not have execute access");
-                    break;
-                }
-
-                // Load accesses must have read permissions
-                if ((TYPE == AccessType::LOAD) && (false == pte.canRead()))
-                {
-                    DLOG("Translation FAILED! PTE does not have read access");
-                    break;
-                }
-
-                // Store accesses must have write permissions
-                constexpr bool is_store = TYPE == AccessType::STORE;
-                if ((is_store) && (false == pte.canWrite()))
+                if (checkLeafPte_<XLEN, MODE, TYPE>(state, pte, pte_paddr, level, priv_mode)
+                    == false)
                 {
-                    DLOG("Translation FAILED! PTE does not have write access");
                     break;
                 }
 
-                if (false == pte.isAccessable(is_store))
+                if (tlb)
                 {
-                    // See if we're required to update access bits in the PTE
-                    if (READ_CSR_FIELD<XLEN>(state, MENVCFG, "adue"))
-                    {
-                        if constexpr (is_store)
-                        {
-                            pte.setDirty();
-                            DLOG("Setting PTE dirty: " << pte);
-                        }
-                        pte.setAccessed();
-                        state->writeMemory<XLEN>(pte_paddr, pte.getPte());
-                    }
-                    else
-                    {
-                        // Take exception -- no access allowed or not dirty
-                        DLOG("Translation FAILED: Cannot access dirty page");
-                        break;
-                    }
+                    tlb->insert(vaddr, MODE, asid, vmid, pte.isGlobal(),
+                                translate_types::getPageOffsetMask<MODE>(indexed_level), level,
+                                pte.getPte(), pte_paddr);
                 }
 
                 // Translate!
-                const Addr index_bits = (vpn_field.msb - vpn_field.lsb + 1) * indexed_level;
-                const Addr virt_base = vaddr >> PAGESHIFT;
-                Addr paddr = (Addr(pte.getPpn()) | (virt_base & ((0b1 << index_bits) - 1)))
-                             << PAGESHIFT;
-                const Addr page_offset_mask =
-                    translate_types::getPageOffsetMask<MODE>(indexed_level);
-                paddr |= page_offset_mask & vaddr;
+                const Addr paddr = calcPAddr_<XLEN, MODE>(pte, level, vaddr);
 
                 // Set result and determine whether to keep going or performa translation again
+                fillSoftTlb_<TYPE>(state, request, paddr);
                 return setResult_<XLEN, MODE, TYPE>(translation_state, action_it, paddr, level);
             }
             // If PTE is NOT a leaf, keep walking the page table
             else
             {
                 ppn = pte.getPpn() << PAGESHIFT;
+                if (page_walk_cache_)
+                {
+                    page_walk_cache_->insert(level, vaddr >> getPageShift_<MODE>(level), MODE,
+                                             root_paddr, ppn);
+                }
             }
 
             // Go to next level
@@ -324,6 +465,120 @@ namespace atlas
         }
     }
 
+    template <typename XLEN, MMUMode MODE, Translate::AccessType TYPE>
+    bool Translate::checkLeafPte_(AtlasState* state, PageTableEntry<XLEN, MODE> & pte,
+                                  const Addr pte_paddr, const uint32_t level,
+                                  const PrivMode priv_mode)
+    {
+        const auto indexed_level = level - 1;
+        const PageSize page_size = translate_types::getPageSize<MODE>(level);
+        DLOG("    Size: " << page_size);
+
+        // TODO: Check page alignment
+
+        // If page is a super page, unused PPN fields should be zero
+        if (page_size != PageSize::SIZE_4K)
+        {
+            bool throw_page_fault = false;
+            for (int32_t ppn_field_idx = indexed_level - 1; ppn_field_idx >= 0;
+                 --ppn_field_idx)
+            {
+                const XLEN ppn_field = pte.getPpnField(ppn_field_idx);
+                if (ppn_field != 0)
+                {
+                    DLOG("Translation FAILED! PPN field " << std::dec << ppn_field_idx
+                                                          << " is not zero: 0x" << std::hex
+                                                          << ppn_field);
+                    throw_page_fault = true;
+                }
+            }
+            if (throw_page_fault)
+            {
+                return false;
+            }
+        }
+
+        // User mode can only access User mode pages. Supervisor mode can never fetch from User
+        // mode pages and can only load from and store to them if the SUM bit is set.
+        const TranslationContext & context = translation_context_;
+        if (priv_mode == PrivMode::USER)
+        {
+            if (false == pte.isUserMode())
+            {
+                DLOG("Translation FAILED! Cannot access Supervisor mode PTE from User mode");
+                return false;
+            }
+        }
+        else if (pte.isUserMode() && ((TYPE == AccessType::INSTRUCTION) || (context.sum == false)))
+        {
+            DLOG("Translation FAILED! Cannot access User mode PTE");
+            return false;
+        }
+
+        // Instruction (fetch) accesses must have execute permissions
+        if ((TYPE == AccessType::INSTRUCTION) && (false == pte.canExecute()))
+        {
+            DLOG("Translation FAILED! PTE does not have execute access");
+            return false;
+        }
+
+        // Load accesses must have read permissions, or execute permissions if MXR is set
+        if ((TYPE == AccessType::LOAD) && (false == pte.canRead())
+            && ((context.mxr == false) || (false == pte.canExecute())))
+        {
+            DLOG("Translation FAILED! PTE does not have read access");
+            return false;
+        }
+
+        // Store accesses must have write permissions
+        constexpr bool is_store = TYPE == AccessType::STORE;
+        if ((is_store) && (false == pte.canWrite()))
+        {
+            DLOG("Translation FAILED! PTE does not have write access");
+            return false;
+        }
+
+        if (false == pte.isAccessable(is_store))
+        {
+            // See if we're required to update access bits in the PTE
+            if (context.adue)
+            {
+                if constexpr (is_store)
+                {
+                    pte.setDirty();
+                    DLOG("Setting PTE dirty: " << pte);
+                }
+                pte.setAccessed();
+                state->writeMemory<XLEN>(pte_paddr, pte.getPte());
+            }
+            else
+            {
+                // Take exception -- no access allowed or not dirty
+                DLOG("Translation FAILED: Cannot access dirty page");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename XLEN, MMUMode MODE>
+    Addr Translate::calcPAddr_(const PageTableEntry<XLEN, MODE> & pte, const uint32_t level,
+                               const Addr vaddr)
+    {
+        constexpr uint64_t PAGESHIFT = 12;
+        const auto indexed_level = level - 1;
+        const auto & vpn_field = translate_types::getVpnField<MODE>(indexed_level);
+        const Addr index_bits = (vpn_field.msb - vpn_field.lsb + 1) * indexed_level;
+        const Addr virt_base = vaddr >> PAGESHIFT;
+        Addr paddr = (Addr(pte.getPpn()) | (virt_base & ((0b1 << index_bits) - 1)))
+                     << PAGESHIFT;
+        const Addr page_offset_mask =
+            translate_types::getPageOffsetMask<MODE>(indexed_level);
+        paddr |= page_offset_mask & vaddr;
+        return paddr;
+    }
+
     template <typename XLEN, MMUMode MODE, Translate::AccessType TYPE>
     Action::ItrType Translate::setResult_(AtlasTranslationState* translation_state,
                                           Action::ItrType action_it, const Addr paddr,
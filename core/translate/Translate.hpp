@@ -1,12 +1,25 @@
 #pragma once
 
 #include "core/ActionGroup.hpp"
+#include "core/translate/AtlasTranslationState.hpp"
+#include "core/translate/PageTableEntry.hpp"
+#include "core/translate/PageWalkCache.hpp"
+#include "core/translate/TLB.hpp"
 #include "core/translate/TranslateTypes.hpp"
+#include "include/ActionTags.hpp"
 #include "include/AtlasTypes.hpp"
 
 #include "sparta/simulation/ParameterSet.hpp"
 #include "sparta/simulation/TreeNode.hpp"
 #include "sparta/simulation/Unit.hpp"
+#include "sparta/statistics/Counter.hpp"
+#include "sparta/statistics/StatisticDef.hpp"
+
+#include <array>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <optional>
 
 class AtlasTranslateTester;
 
@@ -26,6 +39,17 @@ namespace atlas
         {
           public:
             TranslateParameters(sparta::TreeNode* node) : sparta::ParameterSet(node) {}
+
+            PARAMETER(bool, enable_tlb, true, "Cache leaf PTEs in a TLB")
+            PARAMETER(bool, split_tlb, true,
+                      "Separate instruction and data TLBs (a single unified TLB otherwise)")
+            PARAMETER(uint32_t, tlb_num_entries, 64, "Number of entries in each TLB")
+            PARAMETER(uint32_t, tlb_associativity, 4,
+                      "TLB associativity, the number of sets must be a power of 2")
+            PARAMETER(bool, enable_page_walk_cache, true,
+                      "Cache non-leaf PTEs so page walks can skip the upper levels")
+            PARAMETER(uint32_t, page_walk_cache_num_entries, 32,
+                      "Number of entries in the page walk cache (power of 2)")
         };
 
         Translate(sparta::TreeNode* translate_node, const TranslateParameters* p);
@@ -38,6 +62,27 @@ namespace atlas
 
         template <typename XLEN> void changeMMUMode(const MMUMode mode, const MMUMode ls_mode);
 
+        // Translation parameters derived from satp, mstatus, menvcfg and the privilege mode. Page
+        // walks read them from here instead of looking up the CSR fields by name.
+        struct TranslationContext
+        {
+            Addr root_paddr = 0;
+            uint32_t asid = 0;
+            bool sum = false;
+            bool mxr = false;
+            bool adue = false;
+            PrivMode priv_mode = PrivMode::MACHINE;
+            PrivMode ldst_priv_mode = PrivMode::MACHINE;
+
+            bool operator==(const TranslationContext &) const = default;
+        };
+
+        // Must be called whenever satp, mstatus, menvcfg or the privilege mode change. Debug
+        // builds check that the context is up to date on every translation.
+        template <typename XLEN> void updateTranslationContext(AtlasState* state);
+
+        const TranslationContext & getTranslationContext() const { return translation_context_; }
+
         enum class AccessType
         {
             INSTRUCTION,
@@ -45,6 +90,57 @@ namespace atlas
             STORE
         };
 
+        // Soft TLB, maps the virtual pages of data accesses to host pointers into ordinary memory
+        // so loads and stores can skip the translate Action and the memory map. Entries are only
+        // created for memory blocks that have a host pointer (never for MMIO devices) and the
+        // whole TLB is flushed on every MMU mode, privilege mode, satp or mstatus change and on
+        // sfence.vma.
+        static constexpr Addr SOFT_TLB_PAGE_SIZE = 0x1000;
+        static constexpr uint32_t SOFT_TLB_SIZE = 256;
+
+        struct SoftTlbEntry
+        {
+            Addr vpage = std::numeric_limits<Addr>::max();
+            Addr ppage = 0;
+            uint8_t* host_page = nullptr;
+        };
+
+        // Returns the entry for vaddr, or nullptr if the access misses or crosses a page
+        template <AccessType TYPE>
+        const SoftTlbEntry* lookupSoftTlb(const Addr vaddr, const size_t size)
+        {
+            static_assert(TYPE != AccessType::INSTRUCTION);
+            constexpr Addr PAGE_MASK = ~(SOFT_TLB_PAGE_SIZE - 1);
+            const Addr vpage = vaddr & PAGE_MASK;
+            const auto & soft_tlb = (TYPE == AccessType::LOAD) ? load_soft_tlb_ : store_soft_tlb_;
+            const SoftTlbEntry & entry = soft_tlb[(vpage / SOFT_TLB_PAGE_SIZE) % SOFT_TLB_SIZE];
+            if ((entry.vpage == vpage) && (((vaddr + size - 1) & PAGE_MASK) == vpage))
+            {
+                ++soft_tlb_hits_;
+                return &entry;
+            }
+
+            ++soft_tlb_misses_;
+            return nullptr;
+        }
+
+        // Skip the data translate Actions linked in after the compute address Action at
+        // action_it, e.g. when the compute address Action hit in the soft TLB
+        static Action::ItrType skipDataTranslate(Action::ItrType action_it)
+        {
+            ++action_it;
+            while (action_it->hasTag(ActionTags::DATA_TRANSLATE_TAG))
+            {
+                ++action_it;
+            }
+            return action_it;
+        }
+
+        void flushSoftTlb();
+
+        // sfence.vma, see TLB::flush. The page walk cache is always flushed entirely.
+        void flushTlb(const std::optional<Addr> & vaddr, const std::optional<uint32_t> & asid);
+
       private:
         ActionGroup inst_translate_action_group_{"Inst Translate"};
         ActionGroup load_translate_action_group_{"Load Translate"};
@@ -60,6 +156,59 @@ namespace atlas
         template <typename XLEN, MMUMode MODE, AccessType TYPE>
         Action::ItrType translate_(atlas::AtlasState* state, Action::ItrType action_it);
 
+        // Instruction and data TLBs, the data TLB is nullptr if the TLB is unified
+        std::unique_ptr<TLB> inst_tlb_;
+        std::unique_ptr<TLB> data_tlb_;
+
+        TranslationContext translation_context_;
+
+        template <typename XLEN>
+        static TranslationContext makeTranslationContext_(AtlasState* state);
+
+        // Non-leaf PTE cache, nullptr if disabled
+        std::unique_ptr<PageWalkCache> page_walk_cache_;
+
+        sparta::Counter page_walks_;
+        sparta::Counter page_walk_pte_reads_;
+        sparta::Counter page_walk_cache_hits_;
+        sparta::Counter page_walk_cache_misses_;
+        sparta::StatisticDef pte_reads_per_walk_;
+
+        template <AccessType TYPE> TLB* getTLB_()
+        {
+            return ((TYPE == AccessType::INSTRUCTION) || (data_tlb_ == nullptr)) ? inst_tlb_.get()
+                                                                                 : data_tlb_.get();
+        }
+
+        // Check the permissions of a leaf PTE and update its A/D bits
+        template <typename XLEN, MMUMode MODE, AccessType TYPE>
+        bool checkLeafPte_(AtlasState* state, PageTableEntry<XLEN, MODE> & pte,
+                           const Addr pte_paddr, const uint32_t level, const PrivMode priv_mode);
+
+        // Number of virtual address bits below the PTEs of a page table level
+        template <MMUMode MODE> static uint32_t getPageShift_(const uint32_t level)
+        {
+            return std::popcount(translate_types::getPageOffsetMask<MODE>(level - 1));
+        }
+
+        template <typename XLEN, MMUMode MODE>
+        static Addr calcPAddr_(const PageTableEntry<XLEN, MODE> & pte, const uint32_t level,
+                               const Addr vaddr);
+
+        std::array<SoftTlbEntry, SOFT_TLB_SIZE> load_soft_tlb_;
+        std::array<SoftTlbEntry, SOFT_TLB_SIZE> store_soft_tlb_;
+
+        sparta::Counter soft_tlb_hits_;
+        sparta::Counter soft_tlb_misses_;
+        sparta::Counter soft_tlb_flushes_;
+        sparta::StatisticDef soft_tlb_hit_rate_;
+
+        // Add the page of a completed data translation to the soft TLB
+        template <AccessType TYPE>
+        void fillSoftTlb_(AtlasState* state,
+                          const AtlasTranslationState::TranslationRequest & request,
+                          const Addr paddr);
+
         template <typename XLEN, MMUMode MODE, AccessType TYPE>
         Action::ItrType setResult_(AtlasTranslationState* translation_state,
                                    Action::ItrType action_it, const Addr paddr,
@@ -21,6 +21,7 @@ namespace atlas
     bool CoSimMemoryInterface::peek(HartId, Addr paddr, size_t size,
                                     std::vector<uint8_t> & buffer) const
     {
+        buffer.resize(size);
         const bool success = memory_->tryPeek(paddr, size, buffer.data());
         return success;
     }
@@ -28,6 +29,7 @@ namespace atlas
     bool CoSimMemoryInterface::read(HartId, Addr paddr, size_t size,
                                     std::vector<uint8_t> & buffer) const
     {
+        buffer.resize(size);
         const bool success = memory_->tryRead(paddr, size, buffer.data());
         return success;
     }
@@ -46,8 +48,8 @@ namespace atlas
         return success;
     }
 
-    AtlasCoSim::AtlasCoSim(sparta::Scheduler* scheduler, uint64_t ilimit) :
-        AtlasSim(scheduler, {}, {}, ilimit),
+    AtlasCoSim::AtlasCoSim(sparta::Scheduler* scheduler, uint64_t ilimit, uint32_t num_harts) :
+        AtlasSim(scheduler, {}, {}, ilimit, num_harts),
         cosim_logger_(getRoot(), "cosim", "Atlas Cosim Logger")
     {
         buildTree();     // Calls AtlasSim::buildTree_
@@ -61,7 +63,7 @@ namespace atlas
     {
         AtlasSim::bindTree_();
 
-        const uint32_t num_harts = 1;
+        const uint32_t num_harts = getNumHarts();
         for (uint32_t hart_id = 0; hart_id < num_harts; ++hart_id)
         {
             // Get Fetch for each hart
@@ -84,11 +86,14 @@ namespace atlas
 
     cosim::Event AtlasCoSim::step(HartId hart_id)
     {
+        AtlasState* state = state_.at(hart_id);
+        state->loadSoftfloatState();
         ActionGroup* next_action_group = fetch_.at(hart_id)->getActionGroup();
         do
         {
-            next_action_group = next_action_group->execute(state_.at(hart_id));
+            next_action_group = next_action_group->execute(state);
         } while (next_action_group && (next_action_group->hasTag(ActionTags::FETCH_TAG) == false));
+        state->saveSoftfloatState();
 
         const cosim::Event event = cosim_observer_.at(hart_id)->getLastEvent();
         event_list_.at(hart_id).emplace_back(event);
@@ -182,22 +187,22 @@ namespace atlas
         sparta_assert(false, "CoSim method is not implemented!");
     }
 
-    void AtlasCoSim::readRegister(HartId, RegId, std::vector<uint8_t> &) const
+    void AtlasCoSim::readRegister(HartId, RegId, ByteVector &) const
     {
         sparta_assert(false, "CoSim method is not implemented!");
     }
 
-    void AtlasCoSim::peekRegister(HartId, RegId, std::vector<uint8_t> &) const
+    void AtlasCoSim::peekRegister(HartId, RegId, ByteVector &) const
     {
         sparta_assert(false, "CoSim method is not implemented!");
     }
 
-    void AtlasCoSim::writeRegister(HartId, RegId, std::vector<uint8_t> &) const
+    void AtlasCoSim::writeRegister(HartId, RegId, ByteVector &) const
     {
         sparta_assert(false, "CoSim method is not implemented!");
     }
 
-    void AtlasCoSim::pokeRegister(HartId, RegId, std::vector<uint8_t> &) const
+    void AtlasCoSim::pokeRegister(HartId, RegId, ByteVector &) const
     {
         sparta_assert(false, "CoSim method is not implemented!");
     }
@@ -27,7 +27,7 @@ namespace atlas
     class AtlasCoSim : public AtlasSim, public atlas::cosim::CoSim
     {
       public:
-        AtlasCoSim(sparta::Scheduler* scheduler, uint64_t ilimit);
+        AtlasCoSim(sparta::Scheduler* scheduler, uint64_t ilimit, uint32_t num_harts = 1);
         ~AtlasCoSim();
 
         void enableLogger(const std::string & filename = "")
@@ -57,14 +57,10 @@ namespace atlas
         void flush(const cosim::Event* event, bool flush_younger_only = false) override final;
         cosim::MemoryInterface* getMemoryInterface() override final;
         void setMemoryInterface(cosim::MemoryInterface* mem_if) override final;
-        void readRegister(HartId hart, RegId reg,
-                          std::vector<uint8_t> & buffer) const override final;
-        void peekRegister(HartId hart, RegId reg,
-                          std::vector<uint8_t> & buffer) const override final;
-        void writeRegister(HartId hart, RegId reg,
-                           std::vector<uint8_t> & buffer) const override final;
-        void pokeRegister(HartId hart, RegId reg,
-                          std::vector<uint8_t> & buffer) const override final;
+        void readRegister(HartId hart, RegId reg, ByteVector & buffer) const override final;
+        void peekRegister(HartId hart, RegId reg, ByteVector & buffer) const override final;
+        void writeRegister(HartId hart, RegId reg, ByteVector & buffer) const override final;
+        void pokeRegister(HartId hart, RegId reg, ByteVector & buffer) const override final;
         void setPc(HartId hart, Addr pc) override final;
         Addr getPc(HartId hart) const override final;
         void setPrivilegeMode(HartId hart, PrivMode priv_mode) override final;
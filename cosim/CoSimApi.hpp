@@ -160,10 +160,10 @@ namespace atlas::cosim
         ///////////////////////////////////////////////////////////////////////////////////////////
         // Program State
 
-        virtual void readRegister(HartId hart, RegId reg, std::vector<uint8_t> & buffer) const = 0;
-        virtual void peekRegister(HartId hart, RegId reg, std::vector<uint8_t> & buffer) const = 0;
-        virtual void writeRegister(HartId hart, RegId reg, std::vector<uint8_t> & buffer) const = 0;
-        virtual void pokeRegister(HartId hart, RegId reg, std::vector<uint8_t> & buffer) const = 0;
+        virtual void readRegister(HartId hart, RegId reg, ByteVector & buffer) const = 0;
+        virtual void peekRegister(HartId hart, RegId reg, ByteVector & buffer) const = 0;
+        virtual void writeRegister(HartId hart, RegId reg, ByteVector & buffer) const = 0;
+        virtual void pokeRegister(HartId hart, RegId reg, ByteVector & buffer) const = 0;
 
         virtual void setPc(HartId hart, Addr pc) = 0;
         virtual Addr getPc(HartId hart) const = 0;
@@ -2,6 +2,7 @@
 
 #include "include/AtlasTypes.hpp"
 #include "include/AtlasUtils.hpp"
+#include "include/ByteVector.hpp"
 #include "mavis/OpcodeInfo.h"
 
 #include <vector>
@@ -43,9 +44,9 @@ namespace atlas::cosim
         struct RegReadAccess
         {
             RegId reg_id;
-            std::vector<uint8_t> value;
+            ByteVector value;
 
-            RegReadAccess(RegId id, const std::vector<uint8_t> & val) : reg_id(id), value(val) {}
+            RegReadAccess(RegId id, const ByteVector & val) : reg_id(id), value(val) {}
 
             RegReadAccess(RegId id, const uint64_t val) :
                 reg_id(id),
@@ -56,10 +57,9 @@ namespace atlas::cosim
 
         struct RegWriteAccess : public RegReadAccess
         {
-            std::vector<uint8_t> prev_value;
+            ByteVector prev_value;
 
-            RegWriteAccess(RegId id, const std::vector<uint8_t> & val,
-                           const std::vector<uint8_t> & prev_val) :
+            RegWriteAccess(RegId id, const ByteVector & val, const ByteVector & prev_val) :
                 RegReadAccess(id, val),
                 prev_value(prev_val)
             {
@@ -78,12 +78,12 @@ namespace atlas::cosim
             Addr paddr;
             Addr vaddr;
             size_t size;
-            std::vector<uint8_t> value;
+            ByteVector value;
         };
 
         struct MemWriteAccess : public MemReadAccess
         {
-            std::vector<uint8_t> prev_value;
+            ByteVector prev_value;
         };
 
         ////////////////////////////////////////////////////////////////////////////////////////////
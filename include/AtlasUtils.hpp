@@ -1,5 +1,7 @@
 #pragma once
 
+#include "include/ByteVector.hpp"
+
 #include "sparta/utils/SpartaAssert.hpp"
 #include <type_traits>
 
@@ -8,14 +10,15 @@
 
 namespace atlas
 {
-    template <typename T> inline std::vector<uint8_t> convertToByteVector(const T & value)
+    template <typename T> inline ByteVector convertToByteVector(const T & value)
     {
-        std::vector<uint8_t> byte_vector(sizeof(T));
+        static_assert(sizeof(T) <= ByteVector::CAPACITY);
+        ByteVector byte_vector(sizeof(T));
         std::memcpy(byte_vector.data(), &value, sizeof(T));
         return byte_vector;
     }
 
-    template <typename T> inline T convertFromByteVector(const std::vector<uint8_t> & byte_vector)
+    template <typename T> inline T convertFromByteVector(const ByteVector & byte_vector)
     {
         T value;
         sparta_assert(byte_vector.size() == sizeof(T),
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+
+namespace atlas
+{
+    // Fixed capacity byte buffer used to pass register and memory values between the observers,
+    // the cosim events and the cosim memory interface. The bytes are stored inline so building,
+    // copying and resizing a value never allocates. The capacity is the width of the largest
+    // register, a vector register with VLEN=2048.
+    class ByteVector
+    {
+      public:
+        static constexpr size_t CAPACITY = 2048 / 8;
+
+        using value_type = uint8_t;
+        using size_type = size_t;
+        using iterator = uint8_t*;
+        using const_iterator = const uint8_t*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        ByteVector() = default;
+
+        explicit ByteVector(const size_t size, const uint8_t value = 0) { resize(size, value); }
+
+        ByteVector(const uint8_t* bytes, const size_t size) { assign(bytes, size); }
+
+        ByteVector(std::initializer_list<uint8_t> bytes) { assign(bytes.begin(), bytes.size()); }
+
+        // Only copy the bytes in use, not the whole buffer
+        ByteVector(const ByteVector & other) { assign(other.data(), other.size()); }
+
+        ByteVector & operator=(const ByteVector & other)
+        {
+            if (this != &other)
+            {
+                assign(other.data(), other.size());
+            }
+            return *this;
+        }
+
+        void assign(const uint8_t* bytes, const size_t size)
+        {
+            checkSize_(size);
+            std::memcpy(bytes_.data(), bytes, size);
+            size_ = size;
+        }
+
+        // New bytes are set to value, like std::vector::resize
+        void resize(const size_t size, const uint8_t value = 0)
+        {
+            checkSize_(size);
+            if (size > size_)
+            {
+                std::fill(bytes_.begin() + size_, bytes_.begin() + size, value);
+            }
+            size_ = size;
+        }
+
+        void push_back(const uint8_t value)
+        {
+            checkSize_(size_ + 1);
+            bytes_[size_++] = value;
+        }
+
+        void clear() { size_ = 0; }
+
+        size_t size() const { return size_; }
+
+        bool empty() const { return size_ == 0; }
+
+        static constexpr size_t capacity() { return CAPACITY; }
+
+        uint8_t* data() { return bytes_.data(); }
+
+        const uint8_t* data() const { return bytes_.data(); }
+
+        uint8_t & operator[](const size_t idx) { return bytes_[idx]; }
+
+        const uint8_t & operator[](const size_t idx) const { return bytes_[idx]; }
+
+        iterator begin() { return bytes_.data(); }
+
+        iterator end() { return bytes_.data() + size_; }
+
+        const_iterator begin() const { return bytes_.data(); }
+
+        const_iterator end() const { return bytes_.data() + size_; }
+
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        bool operator==(const ByteVector & other) const
+        {
+            return (size_ == other.size_) && (std::memcmp(data(), other.data(), size_) == 0);
+        }
+
+        bool operator!=(const ByteVector & other) const { return !(*this == other); }
+
+      private:
+        // Left uninitialized, only the first size_ bytes are ever read
+        std::array<uint8_t, CAPACITY> bytes_;
+        size_t size_ = 0;
+
+        static void checkSize_(const size_t size)
+        {
+            sparta_assert(size <= CAPACITY,
+                          "Byte vector size (" << size << ") exceeds its capacity (" << CAPACITY
+                                               << ")");
+        }
+    };
+} // namespace atlas
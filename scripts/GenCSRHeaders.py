@@ -165,8 +165,77 @@ def gen_csr_helpers_header():
 
         return '\n'.join(lines)
 
+    def GetFieldDescriptorsCode(RV32_CSR_DEFS, RV64_CSR_DEFS):
+        lines = []
+        lines.append('    // Compile-time CSR field descriptors for READ_CSR_FIELD<XLEN, CSR_FIELDS::<CSR>::<field>>')
+        lines.append('    // and friends. A field only has a bit range for the XLENs that define it.')
+        lines.append('    namespace CSR_FIELDS')
+        lines.append('    {')
+
+        csr_nums = sorted(set(RV32_CSR_DEFS.keys()) | set(RV64_CSR_DEFS.keys()))
+        for csr_num in csr_nums:
+            csr_defn = RV64_CSR_DEFS.get(csr_num, RV32_CSR_DEFS.get(csr_num))
+            rv32_fields = RV32_CSR_DEFS[csr_num][2] if csr_num in RV32_CSR_DEFS else {}
+            rv64_fields = RV64_CSR_DEFS[csr_num][2] if csr_num in RV64_CSR_DEFS else {}
+            rv32_fields = {name.lower(): defn for name, defn in rv32_fields.items()}
+            rv64_fields = {name.lower(): defn for name, defn in rv64_fields.items()}
+            field_names = list(rv64_fields.keys())
+            field_names += [name for name in rv32_fields.keys() if name not in rv64_fields]
+            if not field_names:
+                continue
+
+            lines.append('        struct {}'.format(csr_defn[0].upper()))
+            lines.append('        {')
+            for i, field_name in enumerate(field_names):
+                if i > 0:
+                    lines.append('')
+                lines.append('            struct {}'.format(field_name))
+                lines.append('            {')
+                lines.append('                static constexpr uint32_t reg_num = 0x{:08x};'.format(csr_num))
+                for xlen_name, fields in (('rv32', rv32_fields), ('rv64', rv64_fields)):
+                    if field_name in fields:
+                        lines.append('                static constexpr uint32_t {}_low_bit = {};'.format(
+                            xlen_name, fields[field_name]['low_bit']))
+                        lines.append('                static constexpr uint32_t {}_high_bit = {};'.format(
+                            xlen_name, fields[field_name]['high_bit']))
+                lines.append('            };')
+            lines.append('        };')
+            lines.append('')
+
+        lines.append('    } // namespace CSR_FIELDS')
+        lines.append('')
+        lines.append('    template <typename XLEN, typename FIELD> constexpr uint32_t getCsrFieldLowBit()')
+        lines.append('    {')
+        lines.append('        if constexpr (sizeof(XLEN) == 8) { return FIELD::rv64_low_bit; }')
+        lines.append('        else { return FIELD::rv32_low_bit; }')
+        lines.append('    }')
+        lines.append('')
+        lines.append('    template <typename XLEN, typename FIELD> constexpr uint32_t getCsrFieldHighBit()')
+        lines.append('    {')
+        lines.append('        if constexpr (sizeof(XLEN) == 8) { return FIELD::rv64_high_bit; }')
+        lines.append('        else { return FIELD::rv32_high_bit; }')
+        lines.append('    }')
+        lines.append('')
+        lines.append('    // Mask of the field bits in the CSR value')
+        lines.append('    template <typename XLEN, typename FIELD> constexpr XLEN getCsrFieldMask()')
+        lines.append('    {')
+        lines.append('        constexpr uint32_t low_bit = getCsrFieldLowBit<XLEN, FIELD>();')
+        lines.append('        constexpr uint32_t high_bit = getCsrFieldHighBit<XLEN, FIELD>();')
+        lines.append('        if constexpr ((low_bit == 0) && (high_bit >= (sizeof(XLEN) * 8 - 1)))')
+        lines.append('        {')
+        lines.append('            return ~XLEN(0);')
+        lines.append('        }')
+        lines.append('        else')
+        lines.append('        {')
+        lines.append('            return ((XLEN(1) << (high_bit - low_bit + 1)) - 1) << low_bit;')
+        lines.append('        }')
+        lines.append('    }')
+
+        return '\n'.join(lines)
+
     bit_masks_init_code = GetBitMasksInitCode(CSR32_DEFS, CSR64_DEFS)
     bit_ranges_init_code = GetBitRangesInitCode(CSR32_DEFS, CSR64_DEFS)
+    field_descriptors_code = GetFieldDescriptorsCode(CSR32_DEFS, CSR64_DEFS)
 
     code = f"""#pragma once
 
@@ -185,6 +254,8 @@ namespace atlas
 {bit_masks_init_code}
 
 {bit_ranges_init_code}
+
+{field_descriptors_code}
 }} // namespace atlas
 
 """
@@ -1,19 +1,35 @@
 #include "AtlasSim.hpp"
 #include "include/ActionTags.hpp"
 #include "include/CSRFieldIdxs64.hpp"
+#include <algorithm>
+#include <barrier>
 #include <filesystem>
+#include <thread>
+#include <utility>
 
 #include "sparta/utils/LogUtils.hpp"
 
 namespace atlas
 {
+    namespace
+    {
+        // Hart run by the current host thread when the harts are running in parallel
+        thread_local AtlasState* parallel_hart = nullptr;
+    } // namespace
+
     AtlasSim::AtlasSim(sparta::Scheduler* scheduler, const WorkloadAndArguments & workload_and_args,
-                       const RegValueOverridePairs & reg_value_overrides, uint64_t ilimit) :
+                       const RegValueOverridePairs & reg_value_overrides, uint64_t ilimit,
+                       uint32_t num_harts, uint64_t quantum, bool parallel_harts) :
         sparta::app::Simulation("AtlasSim", scheduler),
         workload_and_args_(workload_and_args),
         reg_value_overrides_(reg_value_overrides),
-        ilimit_(ilimit)
+        ilimit_(ilimit),
+        num_harts_(num_harts),
+        quantum_(quantum),
+        parallel_harts_(parallel_harts)
     {
+        sparta_assert(num_harts_ > 0, "There must be at least one hart");
+        sparta_assert(quantum_ > 0, "The hart quantum must not be 0");
     }
 
     AtlasSim::~AtlasSim()
@@ -40,12 +56,22 @@ namespace atlas
         auto end = std::chrono::system_clock::system_clock::now();
         auto sim_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
-        const HartId hart_id = 0;
-        const AtlasState* state = state_.at(hart_id);
-        const uint64_t inst_count = state->getSimState()->inst_count;
+        uint64_t inst_count = 0;
+        for (const auto state : state_)
+        {
+            inst_count += state->getSimState()->inst_count;
+        }
         std::locale::global(std::locale(""));
         std::cout.imbue(std::locale());
         std::cout.precision(12);
+        if (state_.size() > 1)
+        {
+            for (const auto state : state_)
+            {
+                std::cout << "Instructions executed by hart " << std::dec << state->getHartId()
+                          << ": " << state->getSimState()->inst_count << std::endl;
+            }
+        }
         std::cout << "Instructions executed: " << std::dec << inst_count << std::endl;
         std::cout << "Raw time (seconds): " << std::dec << (sim_time / 1000000.0) << std::endl;
         std::cout << "MIPS: " << std::dec << (inst_count / (sim_time / 1000000.0)) << std::endl;
@@ -98,14 +124,27 @@ namespace atlas
         tns_to_delete_.emplace_back(new sparta::ResourceTreeNode(
             root_tn, "system_call_emulator", "System Call Emulator", &sys_call_factory_));
 
+        for (uint32_t core_idx = 0; core_idx < num_harts_; ++core_idx)
+        {
+            buildCore_(root_tn, core_idx);
+        }
+    }
+
+    void AtlasSim::buildCore_(sparta::TreeNode* root_tn, const uint32_t core_idx)
+    {
         // top.core
         sparta::TreeNode* core_tn = nullptr;
-        const std::string core_name = "core0";
-        const uint32_t core_idx = 0;
+        const std::string core_name = "core" + std::to_string(core_idx);
         tns_to_delete_.emplace_back(
             core_tn = new sparta::ResourceTreeNode(root_tn, core_name, "cores", core_idx,
                                                    "Core State", &state_factory_));
 
+        // top.core.allocators
+        if (parallel_harts_)
+        {
+            core_allocators_tns_.emplace_back(new AtlasAllocators(core_tn));
+        }
+
         // top.core.fetch
         tns_to_delete_.emplace_back(new sparta::ResourceTreeNode(
             core_tn, "fetch", sparta::TreeNode::GROUP_NAME_NONE, sparta::TreeNode::GROUP_IDX_NONE,
@@ -133,6 +172,14 @@ namespace atlas
         auto system_workload_and_args =
             getRoot()->getChildAs<sparta::ParameterBase>("system.params.workload_and_args");
         system_workload_and_args->setValueFromStringVector(workload_and_args_);
+
+        // Each core is a hart with its own ID
+        for (uint32_t hart_id = 0; hart_id < num_harts_; ++hart_id)
+        {
+            auto hart_id_param = getRoot()->getChildAs<sparta::ParameterBase>(
+                "core" + std::to_string(hart_id) + ".params.hart_id");
+            hart_id_param->setValueFromString(std::to_string(hart_id));
+        }
     }
 
     void AtlasSim::bindTree_()
@@ -143,8 +190,7 @@ namespace atlas
             getRoot()->getChild("system_call_emulator")->getResourceAs<atlas::SystemCallEmulator>();
 
         bool system_call_emulator_enabled = false;
-        const uint32_t num_harts = 1;
-        for (uint32_t hart_id = 0; hart_id < num_harts; ++hart_id)
+        for (uint32_t hart_id = 0; hart_id < num_harts_; ++hart_id)
         {
             // Get AtlasState and Fetch for each hart
             const std::string core_name = "core" + std::to_string(hart_id);
@@ -240,10 +286,42 @@ namespace atlas
                 std::cout << std::endl;
             }
 
-            if (false == workload_and_args_.empty())
+            // The program's argument stack is only set up for hart 0. The other harts start at the
+            // same entry point with the same register values, but nothing is written to memory
+            // for them, the workload must give each of them its own stack based on mhartid.
+            if ((false == workload_and_args_.empty()) && (hart_id == 0))
             {
                 state->setupProgramStack(system_->getWorkloadAndArgs());
             }
+
+            Fetch* fetch_unit = core->getChild("fetch")->getResourceAs<Fetch*>();
+
+            // Each hart stops on its own once it has retired ilimit instructions
+            if (ilimit_ > 0)
+            {
+                fetch_unit->addInstCountEvent(
+                    ilimit_,
+                    [this, state]()
+                    {
+                        std::cout << "Instruction limit reached by hart " << std::dec
+                                  << state->getHartId() << ": " << ilimit_ << std::endl;
+                        state->stopSim(INST_LIMIT_EXIT_CODE);
+                    });
+            }
+
+            // Instead of each hart running to completion from its own startup event, hart 0's
+            // startup event runs all of the harts
+            if (num_harts_ > 1)
+            {
+                if (hart_id == 0)
+                {
+                    fetch_unit->setStartupHandler([this]() { runHarts_(); });
+                }
+                else
+                {
+                    fetch_unit->setStartupHandler([]() {});
+                }
+            }
         }
         if (false == workload_and_args_.empty() && system_call_emulator_enabled)
         {
@@ -251,8 +329,133 @@ namespace atlas
         }
     }
 
+    void AtlasSim::runHarts_()
+    {
+        if (parallel_harts_)
+        {
+            // Observers share loggers and files between the harts, so they are only supported
+            // with the deterministic schedule
+            const bool fast_cores = std::all_of(state_.begin(), state_.end(),
+                                                [](const AtlasState* state)
+                                                { return state->isFastCore(); });
+            if (fast_cores)
+            {
+                runHartsParallel_();
+                return;
+            }
+            std::cout << "WARNING: Harts with observers (instruction logging, cosim) cannot run "
+                         "in parallel, running them one quantum at a time instead"
+                      << std::endl;
+        }
+
+        // Interleaving quanta of instructions instead of single instructions keeps each hart's
+        // decode cache, basic blocks and TLBs hot in the host caches while it runs
+        bool running = true;
+        while (running)
+        {
+            running = false;
+            for (auto state : state_)
+            {
+                if (state->getFetchUnit()->runQuantum(quantum_))
+                {
+                    running = true;
+                }
+            }
+        }
+    }
+
+    void AtlasSim::runHartsParallel_()
+    {
+        // Runs on the last hart to reach the barrier while all of the others are waiting, so it
+        // is safe to stop every hart here
+        auto end_quantum = [this]() noexcept
+        {
+            if (parallel_stop_pending_)
+            {
+                for (auto state : state_)
+                {
+                    if (false == state->getSimState()->sim_stopped)
+                    {
+                        state->stopSim(parallel_exit_code_);
+                    }
+                }
+            }
+        };
+        std::barrier quantum_barrier(static_cast<std::ptrdiff_t>(num_harts_), end_quantum);
+
+        parallel_harts_running_ = true;
+        system_->setParallelHartsRunning(true);
+        std::vector<std::thread> threads;
+        threads.reserve(num_harts_);
+        for (auto state : state_)
+        {
+            threads.emplace_back(
+                [this, state, &quantum_barrier]()
+                {
+                    parallel_hart = state;
+                    try
+                    {
+                        Fetch* fetch_unit = state->getFetchUnit();
+                        while (fetch_unit->runQuantum(quantum_))
+                        {
+                            quantum_barrier.arrive_and_wait();
+                        }
+                    }
+                    catch (...)
+                    {
+                        // Stop the other harts and report the exception on the main thread
+                        std::lock_guard<std::mutex> lock(parallel_mutex_);
+                        if (parallel_exception_ == nullptr)
+                        {
+                            parallel_exception_ = std::current_exception();
+                        }
+                        if (false == parallel_stop_pending_)
+                        {
+                            parallel_exit_code_ = 1;
+                            parallel_stop_pending_ = true;
+                        }
+                    }
+
+                    // Stopped harts no longer take part in the quantum barrier
+                    quantum_barrier.arrive_and_drop();
+                    parallel_hart = nullptr;
+                });
+        }
+
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+        parallel_harts_running_ = false;
+        system_->setParallelHartsRunning(false);
+
+        if (parallel_exception_)
+        {
+            std::rethrow_exception(std::exchange(parallel_exception_, nullptr));
+        }
+    }
+
     void AtlasSim::endSimulation(int64_t exit_code)
     {
+        // The other harts are running on their own threads, only the calling hart can be stopped
+        // right away. The others are stopped at the end of the quantum.
+        if (parallel_harts_running_)
+        {
+            {
+                std::lock_guard<std::mutex> lock(parallel_mutex_);
+                if (false == parallel_stop_pending_)
+                {
+                    parallel_exit_code_ = exit_code;
+                    parallel_stop_pending_ = true;
+                }
+            }
+            if (parallel_hart)
+            {
+                parallel_hart->stopSim(exit_code);
+            }
+            return;
+        }
+
         for (auto state : state_)
         {
             state->stopSim(exit_code);
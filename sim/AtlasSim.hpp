@@ -3,6 +3,9 @@
 #include <vector>
 #include <string>
 #include <cinttypes>
+#include <atomic>
+#include <exception>
+#include <mutex>
 
 #include "core/AtlasState.hpp"
 #include "core/Fetch.hpp"
@@ -13,6 +16,8 @@
 #include "sparta/app/Simulation.hpp"
 #include "system/SystemCallEmulator.hpp"
 
+class MultiHartTester;
+
 namespace atlas
 {
     class AtlasSim : public sparta::app::Simulation
@@ -21,8 +26,19 @@ namespace atlas
         using RegValueOverridePairs = std::vector<std::pair<std::string, std::string>>;
         using WorkloadAndArguments = std::vector<std::string>;
 
+        // Harts are interleaved by running each one for quantum instructions in turn
+        static constexpr uint64_t DEFAULT_QUANTUM = 1000;
+
+        // Exit code of a hart stopped by the instruction limit. A workload that did not finish
+        // within the limit must not look like one that passed.
+        static constexpr int64_t INST_LIMIT_EXIT_CODE = 124;
+
+        // ilimit is a per-hart limit: each hart stops once it has retired ilimit instructions
+        // and the simulation ends once every hart has stopped (0 for no limit)
         AtlasSim(sparta::Scheduler* scheduler, const WorkloadAndArguments & workload_and_args,
-                 const RegValueOverridePairs & reg_value_overrides, uint64_t ilimit);
+                 const RegValueOverridePairs & reg_value_overrides, uint64_t ilimit,
+                 uint32_t num_harts = 1, uint64_t quantum = DEFAULT_QUANTUM,
+                 bool parallel_harts = false);
         ~AtlasSim();
 
         // Run the simulator
@@ -32,6 +48,10 @@ namespace atlas
 
         AtlasSystem* getAtlasSystem() const { return system_; }
 
+        uint32_t getNumHarts() const { return num_harts_; }
+
+        bool isParallelHarts() const { return parallel_harts_; }
+
         void enableInteractiveMode();
 
         void setEOTMode(const std::string & eot_mode);
@@ -45,6 +65,26 @@ namespace atlas
         void configureTree_() override;
         void bindTree_() override;
 
+        // Create top.coreN and its units
+        void buildCore_(sparta::TreeNode* root_tn, const uint32_t core_idx);
+
+        // Run the harts one quantum at a time until all of them have stopped
+        void runHarts_();
+
+        // Run each hart on its own host thread, the harts wait for each other at the end of every
+        // quantum
+        void runHartsParallel_();
+
+        // Set by endSimulation while the harts are running on host threads, the other harts are
+        // stopped at the end of the quantum
+        std::atomic<bool> parallel_harts_running_{false};
+        std::atomic<bool> parallel_stop_pending_{false};
+        int64_t parallel_exit_code_ = 0;
+
+        // First exception thrown by a hart thread, rethrown once all of the threads have joined
+        std::exception_ptr parallel_exception_;
+        std::mutex parallel_mutex_;
+
         sparta::ResourceFactory<atlas::Fetch, atlas::Fetch::FetchParameters> fetch_factory_;
         sparta::ResourceFactory<atlas::Translate, atlas::Translate::TranslateParameters>
             translate_factory_;
@@ -59,6 +99,9 @@ namespace atlas
                                 atlas::SystemCallEmulator::SystemCallEmulatorParameters>
             sys_call_factory_;
         std::unique_ptr<AtlasAllocators> allocators_tn_;
+
+        // The allocators are not thread safe, each hart gets its own when running in parallel
+        std::vector<std::unique_ptr<AtlasAllocators>> core_allocators_tns_;
         std::vector<std::unique_ptr<sparta::TreeNode>> tns_to_delete_;
 
         // Atlas State for each hart
@@ -70,8 +113,12 @@ namespace atlas
         const WorkloadAndArguments workload_and_args_;
         const RegValueOverridePairs reg_value_overrides_;
         const uint64_t ilimit_;
+        const uint32_t num_harts_;
+        const uint64_t quantum_;
+        const bool parallel_harts_;
         std::shared_ptr<CoSimQuery> cosim_query_;
 
         friend class AtlasCoSim;
+        friend class ::MultiHartTester;
     };
 } // namespace atlas
@@ -6,7 +6,8 @@
 
 const char USAGE[] =
     "Usage:\n"
-    "./atlas [-i inst limit] [--reg \"name value\"] [--interactive] [--spike-formatting] <workload>"
+    "./atlas [-i inst limit] [--num-harts N] [--quantum insts] [--parallel-harts] "
+    "[--reg \"name value\"] [--interactive] [--spike-formatting] <workload>"
     "\n";
 
 struct RegOverride
@@ -28,6 +29,8 @@ static inline std::istream & operator>>(std::istream & is, RegOverride & into)
 int main(int argc, char** argv)
 {
     uint64_t ilimit = 0;
+    uint32_t num_harts = 1;
+    uint64_t quantum = atlas::AtlasSim::DEFAULT_QUANTUM;
     std::string workload;
     std::string eot_mode;
 
@@ -57,7 +60,12 @@ int main(int argc, char** argv)
         // clang-format off
         app_opts.add_options()
             ("inst-limit,i", po::value<uint64_t>(&ilimit),
-             "Stop simulation after the instruction limit has been reached")
+             "Stop each hart once it has retired this many instructions, the exit status is 124 "
+             "if any hart reached the limit")
+            ("num-harts", po::value<uint32_t>(&num_harts), "Number of harts sharing the system (default 1)")
+            ("quantum", po::value<uint64_t>(&quantum),
+             "Number of instructions each hart executes before switching to the next hart")
+            ("parallel-harts", "Run each hart on its own host thread, synchronizing every quantum")
             ("reg", po::value<std::vector<RegOverride>>()->multitoken(), "Override initial value of a register")
             ("interactive", "Enable interactive mode (IDE)")
             ("eot-mode", po::value<std::string>(&eot_mode), "End of testing mode (pass_fail, magic_mem) [currently IGNORED]")
@@ -106,7 +114,9 @@ int main(int argc, char** argv)
 
         // Create the simulator
         sparta::Scheduler scheduler;
-        atlas::AtlasSim sim(&scheduler, workload_args, reg_value_overrides, ilimit);
+        const bool parallel_harts = vm.count("parallel-harts") > 0;
+        atlas::AtlasSim sim(&scheduler, workload_args, reg_value_overrides, ilimit, num_harts,
+                            quantum, parallel_harts);
 
         cls.populateSimulation(&sim);
 
@@ -129,9 +139,18 @@ int main(int argc, char** argv)
 
         cls.postProcess(&sim);
 
-        // Get workload exit code
+        // Get workload exit code, a hart stopped by the instruction limit fails the run even if
+        // hart 0 finished
         const atlas::AtlasState::SimState* sim_state = sim.getAtlasState()->getSimState();
         exit_code = sim_state->workload_exit_code;
+        for (uint32_t hart_id = 1; hart_id < num_harts; ++hart_id)
+        {
+            if (sim.getAtlasState(hart_id)->getSimState()->workload_exit_code
+                == atlas::AtlasSim::INST_LIMIT_EXIT_CODE)
+            {
+                exit_code = atlas::AtlasSim::INST_LIMIT_EXIT_CODE;
+            }
+        }
         std::cout << "Workload exit code: " << std::dec << exit_code << std::endl;
     }
     catch (...)
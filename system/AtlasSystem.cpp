@@ -3,11 +3,16 @@
 #include "sparta/memory/SimpleMemoryMapNode.hpp"
 #include "sparta/memory/MemoryObject.hpp"
 
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace atlas
 {
 
     AtlasSystem::AtlasSystem(sparta::TreeNode* sys_node, const AtlasSystemParameters* p) :
         sparta::Unit(sys_node),
+        enable_dram_host_access_(p->enable_dram_host_access),
         workload_and_args_(p->workload_and_args)
     {
         if (false == workload_and_args_.empty())
@@ -30,9 +35,26 @@ namespace atlas
             sparta::TreeNode::GROUP_IDX_NONE, "Atlas System Memory Map", ATLAS_SYSTEM_BLOCK_SIZE,
             ATLAS_SYSTEM_TOTAL_MEMORY));
 
+        if (p->sparse_memory_size > 0)
+        {
+            sparta_assert((p->sparse_memory_size % ATLAS_SYSTEM_BLOCK_SIZE) == 0,
+                          "Sparse memory size must be a multiple of the block size");
+            sparta_assert(p->sparse_memory_size <= ATLAS_SYSTEM_TOTAL_MEMORY,
+                          "Sparse memory size is larger than the physical address space");
+            sparse_memory_.reset(new SparseMemory(p->sparse_memory_size, ATLAS_SYSTEM_BLOCK_SIZE,
+                                                  p->sparse_memory_huge_pages));
+        }
+
         // Create memory objects and add them to the memory map
         createMemoryMappings_(sys_node);
 
+        // Workload file for copy-on-write mapping of ELF segments, BSS is already zero filled
+        int workload_fd = -1;
+        if (sparse_memory_ && p->enable_elf_mmap && (false == workload_and_args_.empty()))
+        {
+            workload_fd = ::open(workload_and_args_[0].c_str(), O_RDONLY);
+        }
+
         // Initialize memory with ELF contents
         for (const auto & memory_section : memory_sections_)
         {
@@ -41,6 +63,11 @@ namespace atlas
                 std::cout << "  -- Loading section " << memory_section.name << " (" << std::dec
                           << memory_section.file_size << "B) "
                           << " to 0x" << std::hex << memory_section.start_address << std::endl;
+                if ((workload_fd >= 0) && mapMemorySection_(memory_section, workload_fd))
+                {
+                    continue;
+                }
+
                 bool success = memory_map_->tryPoke(memory_section.start_address,
                                                     memory_section.file_size, memory_section.data);
                 if (!success)
@@ -49,6 +76,67 @@ namespace atlas
                 }
             }
         }
+
+        // The mappings keep their own reference to the file
+        if (workload_fd >= 0)
+        {
+            ::close(workload_fd);
+        }
+    }
+
+    bool AtlasSystem::mapMemorySection_(const MemorySection & memory_section, const int fd)
+    {
+        static const sparta::memory::addr_t host_page_size = ::sysconf(_SC_PAGESIZE);
+        const sparta::memory::addr_t start = memory_section.start_address;
+        const sparta::memory::addr_t end = start + memory_section.file_size;
+
+        // The file offset and the physical address must have the same page offset
+        if ((start % host_page_size) != (memory_section.file_offset % host_page_size))
+        {
+            return false;
+        }
+
+        // Only whole pages can be mapped, the partial pages at either end are shared with whatever
+        // precedes or follows the section
+        const sparta::memory::addr_t map_start =
+            (start + host_page_size - 1) & ~(host_page_size - 1);
+        const sparta::memory::addr_t map_end = end & ~(host_page_size - 1);
+        if (map_end <= map_start)
+        {
+            return false;
+        }
+
+        // The whole section must be in a single sparse memory region (not split by a device)
+        const auto region_it = std::find_if(
+            dram_regions_.begin(), dram_regions_.end(), [start, end](const DramRegion & region)
+            { return (start >= region.start_address) && (end <= region.end_address); });
+        if ((region_it == dram_regions_.end()) || (region_it->sparse_memory == nullptr))
+        {
+            return false;
+        }
+
+        const uint64_t map_file_offset = memory_section.file_offset + (map_start - start);
+        if (false == sparse_memory_->mapFile(map_start, map_end - map_start, fd, map_file_offset))
+        {
+            return false;
+        }
+
+        bool success = true;
+        if (start < map_start)
+        {
+            success &= memory_map_->tryPoke(start, map_start - start, memory_section.data);
+        }
+        if (map_end < end)
+        {
+            success &= memory_map_->tryPoke(map_end, end - map_end,
+                                            memory_section.data + (map_end - start));
+        }
+        if (!success)
+        {
+            std::cout << "FAILED!\n";
+        }
+
+        return true;
     }
 
     void AtlasSystem::loadWorkload_(const std::string & workload)
@@ -170,9 +258,11 @@ namespace atlas
                 + ATLAS_SYSTEM_BLOCK_SIZE;
 
             MemorySection section = {(segment_name.empty() ? "?" : segment_name),
-                                     segment->get_file_size(), size_aligned,
+                                     segment->get_file_size(),
+                                     size_aligned,
                                      segment->get_physical_address(),
-                                     reinterpret_cast<const uint8_t*>(segment->get_data())};
+                                     reinterpret_cast<const uint8_t*>(segment->get_data()),
+                                     segment->get_offset()};
             memory_sections_.emplace_back(section);
         }
 
@@ -183,13 +273,6 @@ namespace atlas
 
     void AtlasSystem::createMemoryMappings_(sparta::TreeNode* sys_node)
     {
-        using BMOIfNode = sparta::memory::BlockingMemoryObjectIFNode;
-        using BMIfNode = sparta::memory::BlockingMemoryIFNode;
-        using MemObj = sparta::memory::MemoryObject;
-
-        BMIfNode* memory_if = nullptr;
-        MemObj* mem_obj = nullptr;
-
         // The allocated memory blocks (Magic Mem, UART, etc)
         struct AllocatedMemoryBlock
         {
@@ -256,7 +339,6 @@ namespace atlas
         ////////////////////////////////////////////////////////////////////////////////
         // Now fill in the memory "blanks"
         sparta::memory::addr_t addr_block_start = 0;
-        const uint32_t illop = 0;
         uint32_t block_num = 1;
 
         while (false == allocated_blocks.empty())
@@ -269,17 +351,7 @@ namespace atlas
             if (addr_block_start < alloc_block.start_address)
             {
                 // Add a memory block up to the allocated block
-                const auto block_size = alloc_block.start_address - addr_block_start;
-                memory_objects_.emplace_back(mem_obj =
-                                                 new MemObj(sys_node, ATLAS_SYSTEM_BLOCK_SIZE,
-                                                            block_size, illop, sizeof(illop)));
-                tree_nodes_.emplace_back(memory_if = new BMOIfNode(
-                                             sys_node, "mb_" + std::to_string(block_num),
-                                             sparta::TreeNode::GROUP_NAME_NONE,
-                                             sparta::TreeNode::GROUP_IDX_NONE,
-                                             "mb_" + std::to_string(block_num), nullptr, *mem_obj));
-                memory_map_->addMapping(addr_block_start, addr_block_start + block_size, memory_if,
-                                        0x0 /* Additional offset */);
+                addDramRegion_(sys_node, addr_block_start, alloc_block.start_address, block_num);
             }
 
             // Determine the next large block of memory
@@ -291,18 +363,76 @@ namespace atlas
         }
 
         // Add the rest of memory
-        memory_objects_.emplace_back(mem_obj =
-                                         new MemObj(sys_node, ATLAS_SYSTEM_BLOCK_SIZE,
-                                                    ATLAS_SYSTEM_TOTAL_MEMORY - addr_block_start,
-                                                    illop, sizeof(illop)));
+        addDramRegion_(sys_node, addr_block_start, ATLAS_SYSTEM_TOTAL_MEMORY, block_num);
+        memory_map_->dumpMappings(std::cout);
+    }
+
+    void AtlasSystem::addDramRegion_(sparta::TreeNode* sys_node,
+                                     sparta::memory::addr_t start_address,
+                                     sparta::memory::addr_t end_address, uint32_t block_num)
+    {
+        using BMOIfNode = sparta::memory::BlockingMemoryObjectIFNode;
+        using BMIfNode = sparta::memory::BlockingMemoryIFNode;
+        using MemObj = sparta::memory::MemoryObject;
+
+        // Sparse memory sees physical addresses, so the mapping offset is the start address
+        if (sparse_memory_ && (start_address < sparse_memory_->getSize()))
+        {
+            const sparta::memory::addr_t sparse_end =
+                std::min(end_address, sparse_memory_->getSize());
+            memory_map_->addMapping(start_address, sparse_end, sparse_memory_.get(),
+                                    start_address /* Additional offset */);
+            dram_regions_.push_back({start_address, sparse_end, nullptr, sparse_memory_.get()});
+            start_address = sparse_end;
+        }
+
+        if (start_address >= end_address)
+        {
+            return;
+        }
+
+        BMIfNode* memory_if = nullptr;
+        MemObj* mem_obj = nullptr;
+        const uint32_t illop = 0;
+        memory_objects_.emplace_back(mem_obj = new MemObj(sys_node, ATLAS_SYSTEM_BLOCK_SIZE,
+                                                          end_address - start_address, illop,
+                                                          sizeof(illop)));
         tree_nodes_.emplace_back(
             memory_if =
                 new BMOIfNode(sys_node, "mb_" + std::to_string(block_num),
                               sparta::TreeNode::GROUP_NAME_NONE, sparta::TreeNode::GROUP_IDX_NONE,
                               "mb_" + std::to_string(block_num), nullptr, *mem_obj));
-        memory_map_->addMapping(addr_block_start, ATLAS_SYSTEM_TOTAL_MEMORY, memory_if,
-                                0x0 /* Additional offset */);
-        memory_map_->dumpMappings(std::cout);
+        memory_map_->addMapping(start_address, end_address, memory_if, 0x0 /* Additional offset */);
+        dram_regions_.push_back({start_address, end_address, mem_obj, nullptr});
+    }
+
+    uint8_t* AtlasSystem::getHostBlock(const Addr paddr)
+    {
+        if (false == enable_dram_host_access_)
+        {
+            return nullptr;
+        }
+
+        for (const auto & region : dram_regions_)
+        {
+            if ((paddr >= region.start_address) && (paddr < region.end_address))
+            {
+                if (region.sparse_memory)
+                {
+                    return region.sparse_memory->getHostPtr(paddr & ~(ATLAS_SYSTEM_BLOCK_SIZE - 1));
+                }
+
+                // Memory blocks are allocated on first access and never freed, so the pointer to
+                // the block's data is stable
+                const sparta::memory::addr_t offset =
+                    (paddr - region.start_address) & ~(ATLAS_SYSTEM_BLOCK_SIZE - 1);
+                const auto lock = lockMemoryMap();
+                sparta::ArchData::Line & line = region.memory_object->getLine(offset);
+                return line.getRawDataPtr(offset - line.getOffset());
+            }
+        }
+
+        return nullptr;
     }
 
     void AtlasSystem::enableEOTPassFailMode()
@@ -5,6 +5,8 @@
 #include "include/AtlasTypes.hpp"
 #include "system/SimpleUART.hpp"
 #include "system/MagicMemory.hpp"
+#include "system/SparseMemory.hpp"
+#include "system/ReservationTable.hpp"
 
 #include "sparta/simulation/Unit.hpp"
 #include "sparta/simulation/ParameterSet.hpp"
@@ -12,6 +14,8 @@
 #include "sparta/simulation/ResourceTreeNode.hpp"
 #include "sparta/simulation/ResourceFactory.hpp"
 
+#include <mutex>
+
 namespace sparta::memory
 {
     class MemoryObject;
@@ -34,6 +38,17 @@ namespace atlas
             AtlasSystemParameters(sparta::TreeNode* node) : sparta::ParameterSet(node) {}
 
             PARAMETER(bool, enable_uart, false, "Enable a Uart")
+            PARAMETER(bool, enable_dram_host_access, true,
+                      "Access ordinary memory through host pointers instead of the memory map "
+                      "(no observers only)")
+            PARAMETER(uint64_t, sparse_memory_size, 0x1000000000,
+                      "Size of the physical address range starting at 0 that is backed by a lazily "
+                      "committed host mmap reservation. Memory above it uses sparta memory "
+                      "objects. 0 to only use sparta memory objects")
+            PARAMETER(bool, sparse_memory_huge_pages, false,
+                      "Back sparse memory with transparent huge pages")
+            PARAMETER(bool, enable_elf_mmap, true,
+                      "Map ELF segments copy-on-write into sparse memory instead of copying them")
             HIDDEN_PARAMETER(std::vector<std::string>, workload_and_args, {},
                              "Workload and command line arguments")
         };
@@ -55,6 +70,26 @@ namespace atlas
 
         const std::unordered_map<Addr, std::string> & getSymbols() const { return symbols_; }
 
+        // Get a host pointer to the memory block (ATLAS_SYSTEM_BLOCK_SIZE bytes) containing paddr.
+        // Returns nullptr if the block is not ordinary memory (Magic Memory, UART) or host access
+        // is disabled. The pointer remains valid for the lifetime of the system.
+        uint8_t* getHostBlock(const Addr paddr);
+
+        // Serializes accesses through the memory map (devices, lazily allocated memory blocks,
+        // system calls) when the harts are running on their own host threads. Otherwise the
+        // returned lock does not own the mutex. Host pointer accesses do not need it.
+        std::unique_lock<std::mutex> lockMemoryMap()
+        {
+            return parallel_harts_running_ ? std::unique_lock<std::mutex>(memory_map_mutex_)
+                                           : std::unique_lock<std::mutex>();
+        }
+
+        // Only changed while none of the harts are running
+        void setParallelHartsRunning(const bool running) { parallel_harts_running_ = running; }
+
+        // LR/SC reservations of all of the harts
+        ReservationTable* getReservationTable() { return &reservation_table_; }
+
         constexpr static sparta::memory::addr_t ATLAS_SYSTEM_BLOCK_SIZE = 0x1000; // 4K
         constexpr static sparta::memory::addr_t ATLAS_SYSTEM_TOTAL_MEMORY =
             0x8000000000000000; // 4G
@@ -75,6 +110,23 @@ namespace atlas
         // Memory and memory maps
         std::unique_ptr<sparta::memory::SimpleMemoryMapNode> memory_map_;
         std::vector<std::unique_ptr<sparta::memory::MemoryObject>> memory_objects_;
+        std::unique_ptr<SparseMemory> sparse_memory_;
+        std::mutex memory_map_mutex_;
+        bool parallel_harts_running_ = false;
+        ReservationTable reservation_table_;
+
+        // Ordinary memory regions that can be accessed through host pointers. Each region is
+        // backed either by sparse memory or by a sparta memory object.
+        struct DramRegion
+        {
+            sparta::memory::addr_t start_address = 0;
+            sparta::memory::addr_t end_address = 0;
+            sparta::memory::MemoryObject* memory_object = nullptr;
+            SparseMemory* sparse_memory = nullptr;
+        };
+
+        const bool enable_dram_host_access_;
+        std::vector<DramRegion> dram_regions_;
 
         struct MemorySection
         {
@@ -83,17 +135,20 @@ namespace atlas
             sparta::memory::addr_t total_size_aligned = 0;
             sparta::memory::addr_t start_address = 0;
             const uint8_t* data = nullptr;
+            uint64_t file_offset = 0;
 
             MemorySection() = default;
 
             MemorySection(const std::string name, const sparta::memory::addr_t file_size,
                           const sparta::memory::addr_t total_size_aligned,
-                          const sparta::memory::addr_t start_address, const uint8_t* data) :
+                          const sparta::memory::addr_t start_address, const uint8_t* data,
+                          const uint64_t file_offset = 0) :
                 name(name),
                 file_size(file_size),
                 total_size_aligned(total_size_aligned),
                 start_address(start_address),
-                data(data)
+                data(data),
+                file_offset(file_offset)
             {
             }
         };
@@ -103,6 +158,15 @@ namespace atlas
 
         void createMemoryMappings_(sparta::TreeNode* sys_node);
 
+        // Map the page aligned middle of a section copy-on-write from the workload file into
+        // sparse memory and poke the rest. Returns false if the section must be poked instead.
+        bool mapMemorySection_(const MemorySection & memory_section, const int fd);
+
+        // Map ordinary memory from start_address to end_address, using sparse memory for the part
+        // that it covers
+        void addDramRegion_(sparta::TreeNode* sys_node, sparta::memory::addr_t start_address,
+                            sparta::memory::addr_t end_address, uint32_t block_num);
+
         // Workload and workload arguments
         const std::vector<std::string> workload_and_args_;
         void loadWorkload_(const std::string & workload);
@@ -0,0 +1,84 @@
+#include "system/ReservationTable.hpp"
+
+namespace atlas
+{
+    ReservationTable::ReservationTable()
+    {
+        for (auto & set : hart_sets_)
+        {
+            set.store(NO_RESERVATION, std::memory_order_relaxed);
+        }
+        for (auto & harts : bucket_harts_)
+        {
+            harts.store(0, std::memory_order_relaxed);
+        }
+        hart_buckets_.fill(NUM_BUCKETS);
+    }
+
+    void ReservationTable::reserve(const HartId hart_id, const Addr paddr)
+    {
+        sparta_assert(hart_id < MAX_HARTS, "LR/SC reservations are supported for up to "
+                                               << MAX_HARTS << " harts, hart ID is " << hart_id);
+        clear(hart_id);
+
+        // Set the bucket bit before the reservation so a concurrent store can not miss it
+        const Addr set = getSet_(paddr);
+        const uint32_t bucket = getBucket_(set);
+        if (hart_buckets_[hart_id] != bucket)
+        {
+            if (hart_buckets_[hart_id] != NUM_BUCKETS)
+            {
+                bucket_harts_[hart_buckets_[hart_id]].fetch_and(~getHartMask_(hart_id));
+            }
+            bucket_harts_[bucket].fetch_or(getHartMask_(hart_id));
+            hart_buckets_[hart_id] = bucket;
+        }
+
+        num_active_.fetch_add(1);
+        hart_sets_[hart_id].store(set);
+    }
+
+    bool ReservationTable::isReserved(const HartId hart_id, const Addr paddr) const
+    {
+        return (hart_id < MAX_HARTS) && (hart_sets_[hart_id].load() == getSet_(paddr));
+    }
+
+    void ReservationTable::clear(const HartId hart_id)
+    {
+        if (hart_id >= MAX_HARTS)
+        {
+            return;
+        }
+
+        // A store by another hart may clear the reservation at the same time, only one of them
+        // decrements the count
+        if (hart_sets_[hart_id].exchange(NO_RESERVATION) != NO_RESERVATION)
+        {
+            num_active_.fetch_sub(1);
+        }
+    }
+
+    void ReservationTable::clearOtherReservations_(const HartId hart_id, const Addr paddr,
+                                                   const size_t size)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        const uint64_t other_harts_mask = ~getHartMask_(hart_id);
+        const Addr last_set = getSet_(paddr + size - 1);
+        for (Addr set = getSet_(paddr); set <= last_set; ++set)
+        {
+            uint64_t harts = bucket_harts_[getBucket_(set)].load() & other_harts_mask;
+            while (harts)
+            {
+                const HartId other_hart_id = __builtin_ctzll(harts);
+                harts &= harts - 1;
+
+                Addr expected_set = set;
+                if (hart_sets_[other_hart_id].compare_exchange_strong(expected_set,
+                                                                      NO_RESERVATION))
+                {
+                    num_active_.fetch_sub(1);
+                }
+            }
+        }
+    }
+} // namespace atlas
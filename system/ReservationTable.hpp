@@ -0,0 +1,114 @@
+#pragma once
+
+#include "include/AtlasTypes.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace atlas
+{
+    /*!
+     * \class ReservationTable
+     * \brief LR/SC reservation sets of all of the harts sharing memory
+     *
+     * LR reserves the 64 byte block (the reservation set) containing the loaded address. A store
+     * by another hart to any byte of a reserved block clears the reservation, so the hart's next
+     * SC fails.
+     *
+     * Every store has to check the table, so the common case of no live reservations is a single
+     * relaxed load. Otherwise the stored block is hashed into a bucket holding a bitmask of the
+     * harts with a reservation in a block that maps to that bucket, and only those harts'
+     * reservations are compared.
+     *
+     * The table can be updated by harts running on different host threads. Stores check the
+     * table after writing memory and LR reserves before reading memory. SC checks that the hart
+     * still holds its reservation and stores while holding the table lock, and stores that find
+     * live reservations take the same lock to clear them, so a store by another hart either
+     * clears the reservation before the SC checks it or waits until the SC has stored.
+     */
+    class ReservationTable
+    {
+      public:
+        static constexpr Addr RESERVATION_SET_SIZE = 64;
+        static constexpr uint32_t MAX_HARTS = 64;
+
+        ReservationTable();
+
+        bool isAnyReservationActive() const
+        {
+            return num_active_.load(std::memory_order_relaxed) != 0;
+        }
+
+        // Replace the hart's reservation with the reservation set containing paddr
+        void reserve(const HartId hart_id, const Addr paddr);
+
+        // Returns true if the hart still holds a reservation on the set containing paddr
+        bool isReserved(const HartId hart_id, const Addr paddr) const;
+
+        // Drop the hart's reservation, if any
+        void clear(const HartId hart_id);
+
+        // Call store() to store size bytes at paddr if the hart still holds a reservation on the
+        // set containing paddr, and clear the other harts' reservations on the stored bytes.
+        // Always drops the hart's reservation. Returns true if the SC succeeded.
+        template <typename StoreFunc>
+        bool storeConditional(const HartId hart_id, const Addr paddr, const size_t size,
+                              const StoreFunc & store)
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            const bool reserved = isReserved(hart_id, paddr);
+            if (reserved)
+            {
+                store();
+                clearOtherReservations_(hart_id, paddr, size);
+            }
+            clear(hart_id);
+            return reserved;
+        }
+
+        // Called after a hart stores size bytes at paddr, clears the other harts' reservations on
+        // the stored bytes
+        void snoopStore(const HartId hart_id, const Addr paddr, const size_t size)
+        {
+            if (SPARTA_EXPECT_FALSE(isAnyReservationActive()))
+            {
+                clearOtherReservations_(hart_id, paddr, size);
+            }
+        }
+
+      private:
+        static constexpr uint32_t NUM_BUCKETS = 256;
+        static constexpr Addr NO_RESERVATION = ~Addr(0);
+
+        static Addr getSet_(const Addr paddr) { return paddr / RESERVATION_SET_SIZE; }
+
+        static uint32_t getBucket_(const Addr set) { return set % NUM_BUCKETS; }
+
+        static uint64_t getHartMask_(const HartId hart_id) { return uint64_t(1) << hart_id; }
+
+        void clearOtherReservations_(const HartId hart_id, const Addr paddr, const size_t size);
+
+        // Held by SC and by stores clearing reservations. Recursive since the store done by an SC
+        // snoops the table.
+        std::recursive_mutex mutex_;
+
+        // Number of harts holding a reservation, kept apart from the rest of the table since it
+        // is read by every store
+        alignas(64) std::atomic<uint32_t> num_active_{0};
+
+        // Reservation set held by each hart, or NO_RESERVATION. Only the hart itself sets it,
+        // stores by other harts can only clear it.
+        alignas(64) std::array<std::atomic<Addr>, MAX_HARTS> hart_sets_;
+
+        // Harts with a reservation set mapping to each bucket. Bits are only set and cleared by
+        // their hart, so a bit may remain set after a store has cleared the reservation.
+        std::array<std::atomic<uint64_t>, NUM_BUCKETS> bucket_harts_;
+
+        // Bucket with each hart's bit set, only accessed by the hart itself
+        std::array<uint32_t, MAX_HARTS> hart_buckets_;
+    };
+} // namespace atlas
@@ -0,0 +1,99 @@
+#include "system/SparseMemory.hpp"
+
+#include "sparta/utils/SpartaAssert.hpp"
+#include "sparta/utils/SpartaException.hpp"
+
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace atlas
+{
+    SparseMemory::SparseMemory(const sparta::memory::addr_t size,
+                               const sparta::memory::addr_t block_size,
+                               const bool use_huge_pages) :
+        sparta::memory::BlockingMemoryIF("Sparse Memory", block_size, {0, size, "sparse_memory"},
+                                         nullptr),
+        size_(size)
+    {
+        // Reserve the address range without committing swap or host memory for it
+        void* base = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED)
+        {
+            throw sparta::SpartaException()
+                << "Failed to reserve 0x" << std::hex << size_
+                << " bytes of host memory for sparse memory: " << std::strerror(errno)
+                << ". Reduce top.system.params.sparse_memory_size.";
+        }
+        base_ = static_cast<uint8_t*>(base);
+
+        // Transparent huge pages are only a hint, keep going if the host does not support them
+        if (use_huge_pages)
+        {
+#ifdef MADV_HUGEPAGE
+            if (::madvise(base_, size_, MADV_HUGEPAGE) != 0)
+            {
+                std::cout << "WARNING: Transparent huge pages are not available for sparse memory: "
+                          << std::strerror(errno) << std::endl;
+            }
+#else
+            std::cout << "WARNING: Transparent huge pages are not supported on this host"
+                      << std::endl;
+#endif
+        }
+    }
+
+    SparseMemory::~SparseMemory() { ::munmap(base_, size_); }
+
+    bool SparseMemory::mapFile(const sparta::memory::addr_t addr,
+                               const sparta::memory::addr_t size, const int fd,
+                               const uint64_t file_offset)
+    {
+        sparta_assert((addr + size) <= size_, "File mapping is outside of sparse memory");
+
+        // Private mappings are copy-on-write, guest stores never reach the file
+        void* host_ptr = ::mmap(base_ + addr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                                fd, static_cast<off_t>(file_offset));
+        if (host_ptr != MAP_FAILED)
+        {
+            return true;
+        }
+
+        // A failed fixed mapping may have removed part of the reservation, restore it
+        host_ptr = ::mmap(base_ + addr, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+        sparta_assert(host_ptr != MAP_FAILED, "Failed to restore sparse memory after a failed "
+                                              "file mapping: " << std::strerror(errno));
+        return false;
+    }
+
+    bool SparseMemory::tryRead_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                                uint8_t* buf, const void*, void*)
+    {
+        ::memcpy(buf, base_ + addr, size);
+        return true;
+    }
+
+    bool SparseMemory::tryWrite_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                                 const uint8_t* buf, const void*, void*)
+    {
+        ::memcpy(base_ + addr, buf, size);
+        return true;
+    }
+
+    bool SparseMemory::tryPeek_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                                uint8_t* buf) const
+    {
+        ::memcpy(buf, base_ + addr, size);
+        return true;
+    }
+
+    bool SparseMemory::tryPoke_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                                const uint8_t* buf)
+    {
+        ::memcpy(base_ + addr, buf, size);
+        return true;
+    }
+} // namespace atlas
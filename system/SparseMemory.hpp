@@ -0,0 +1,51 @@
+#pragma once
+
+#include "sparta/memory/BlockingMemoryIF.hpp"
+
+namespace atlas
+{
+    /*!
+     * \class SparseMemory
+     * \brief Ordinary memory backed by an anonymous host mmap reservation
+     *
+     * The whole range is reserved up front without committing any host memory. The host kernel
+     * commits zero filled pages on first touch, so a large guest physical address space costs
+     * nothing until it is used. Address N of the memory is always at host address base + N, there
+     * are no block tables to walk.
+     *
+     * SparseMemory can be added to the memory map several times (once for each range between
+     * devices) with the mapping offset set to the start of the range, so the address seen by the
+     * memory is always the physical address.
+     */
+    class SparseMemory : public sparta::memory::BlockingMemoryIF
+    {
+      public:
+        SparseMemory(const sparta::memory::addr_t size, const sparta::memory::addr_t block_size,
+                     const bool use_huge_pages);
+
+        ~SparseMemory();
+
+        sparta::memory::addr_t getSize() const { return size_; }
+
+        // Host pointer to addr, which must be less than getSize()
+        uint8_t* getHostPtr(const sparta::memory::addr_t addr) const { return base_ + addr; }
+
+        // Map size bytes of a file at file_offset copy-on-write at addr. addr, size and
+        // file_offset must be host page aligned. Returns false if the host cannot map the file.
+        bool mapFile(const sparta::memory::addr_t addr, const sparta::memory::addr_t size,
+                     const int fd, const uint64_t file_offset);
+
+      private:
+        const sparta::memory::addr_t size_;
+        uint8_t* base_ = nullptr;
+
+        bool tryRead_(sparta::memory::addr_t addr, sparta::memory::addr_t size, uint8_t* buf,
+                      const void* in_supplement, void* out_supplement) override final;
+        bool tryWrite_(sparta::memory::addr_t addr, sparta::memory::addr_t size, const uint8_t* buf,
+                       const void* in_supplement, void* out_supplement) override final;
+        bool tryPeek_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                      uint8_t* buf) const override final;
+        bool tryPoke_(sparta::memory::addr_t addr, sparta::memory::addr_t size,
+                      const uint8_t* buf) override final;
+    };
+} // namespace atlas
@@ -3,8 +3,12 @@
 
 #include "sparta/utils/SpartaTester.hpp"
 
+#include <chrono>
+#include <iomanip>
+
 void runSim(atlas::AtlasState* state, atlas::ActionGroup* atlas_core,
-            const uint32_t expected_num_insts, const uint32_t expected_num_action_groups)
+            const uint32_t expected_num_insts, const uint32_t expected_num_action_groups,
+            const bool threaded_dispatch = false)
 {
     state->setPc(0x1000);
     state->getSimState()->inst_count = 0;
@@ -13,7 +17,8 @@ void runSim(atlas::AtlasState* state, atlas::ActionGroup* atlas_core,
     uint32_t num_action_groups_executed = 0;
     while (action_group)
     {
-        action_group = action_group->execute(state);
+        action_group = threaded_dispatch ? action_group->executeThreaded(state)
+                                         : action_group->execute(state);
         ++num_action_groups_executed;
     }
 
@@ -35,8 +40,57 @@ class dummyClass
     }
 };
 
-int main()
+// Diverts execution to another ActionGroup, the same way a trap diverts to the Exception unit
+class trapClass
+{
+  public:
+    using base_type = trapClass;
+
+    trapClass(atlas::ActionGroup* trap_action_group) : trap_action_group_(trap_action_group) {}
+
+    atlas::Action::ItrType countAction(atlas::AtlasState*, atlas::Action::ItrType action_it)
+    {
+        ++num_actions_executed;
+        return ++action_it;
+    }
+
+    atlas::Action::ItrType redirectAction(atlas::AtlasState* state, atlas::Action::ItrType)
+    {
+        return state->redirectActionGroup(trap_action_group_);
+    }
+
+    atlas::Action::ItrType throwAction(atlas::AtlasState*, atlas::Action::ItrType)
+    {
+        throw atlas::ActionException(trap_action_group_);
+    }
+
+    uint32_t num_actions_executed = 0;
+
+  private:
+    atlas::ActionGroup* trap_action_group_;
+};
+
+// Execute a trapping ActionGroup repeatedly and report the number of traps taken per second
+void benchmarkTraps(atlas::AtlasState* state, atlas::ActionGroup* action_group,
+                    const bool threaded_dispatch)
+{
+    const uint64_t num_traps = 1000000;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t trap_num = 0; trap_num < num_traps; ++trap_num)
+    {
+        threaded_dispatch ? action_group->executeThreaded(state) : action_group->execute(state);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "    " << action_group->getName() << (threaded_dispatch ? " (threaded)" : "")
+              << ": " << std::fixed << std::setprecision(1)
+              << (num_traps / elapsed.count()) / 1000000.0 << "M traps/sec" << std::endl;
+}
+
+int main(int argc, char** argv)
 {
+    // The trap throughput benchmark is only run on request, it does not check anything
+    const bool run_benchmarks = (argc > 1) && (std::string(argv[1]) == "--benchmark");
+
     // Create the simulator
     sparta::Scheduler scheduler_;
     const uint64_t ilimit = 0;
@@ -168,6 +222,70 @@ int main()
     // each vadd.vv counts as 2 insts + wfi
     runSim(state, fetch, 11, 31);
 
+    //
+    // Same workload with direct threaded dispatch
+    //
+    std::cout << "TEST: Threaded Dispatch\n";
+    runSim(state, fetch, 11, 31, true);
+
+    // Modifying an ActionGroup is picked up by threaded dispatch
+    fetch->insertActionAfter(dummy_action, atlas::ActionTags::FETCH_TAG);
+    runSim(state, fetch, 11, 31, true);
+    fetch->removeAction(DUMMY_TAG);
+    runSim(state, fetch, 11, 31, true);
+
+    //
+    // Redirect an ActionGroup without throwing, the remaining Actions are skipped
+    //
+    std::cout << "TEST: Redirect ActionGroup\n";
+    atlas::ActionGroup trap_handler{"Trap Handler"};
+    trapClass trap_class{&trap_handler};
+    atlas::Action count_action =
+        atlas::Action::createAction<&trapClass::countAction>(&trap_class, "Count");
+    atlas::ActionGroup redirect_group{"Redirect"};
+    redirect_group.addAction(count_action);
+    redirect_group.addAction(
+        atlas::Action::createAction<&trapClass::redirectAction>(&trap_class, "Redirect"));
+    redirect_group.addAction(count_action);
+    redirect_group.setNextActionGroup(fetch);
+    atlas::ActionGroup throw_group{"Throw"};
+    throw_group.addAction(count_action);
+    throw_group.addAction(
+        atlas::Action::createAction<&trapClass::throwAction>(&trap_class, "Throw"));
+    throw_group.addAction(count_action);
+    throw_group.setNextActionGroup(fetch);
+
+    for (const bool threaded_dispatch : {false, true})
+    {
+        for (atlas::ActionGroup* action_group : {&redirect_group, &throw_group})
+        {
+            trap_class.num_actions_executed = 0;
+            atlas::ActionGroup* next_action_group = threaded_dispatch
+                                                        ? action_group->executeThreaded(state)
+                                                        : action_group->execute(state);
+            EXPECT_EQUAL(next_action_group, &trap_handler);
+            EXPECT_EQUAL(trap_class.num_actions_executed, 1u);
+        }
+
+        // The redirect does not leak into the next ActionGroup
+        atlas::ActionGroup* next_action_group =
+            threaded_dispatch ? trap_handler.executeThreaded(state) : trap_handler.execute(state);
+        EXPECT_TRUE(next_action_group == nullptr);
+    }
+
+    //
+    // Trap throughput of redirecting vs. throwing an ActionException
+    //
+    if (run_benchmarks)
+    {
+        std::cout << "BENCHMARK: Trap Throughput\n";
+        for (const bool threaded_dispatch : {false, true})
+        {
+            benchmarkTraps(state, &redirect_group, threaded_dispatch);
+            benchmarkTraps(state, &throw_group, threaded_dispatch);
+        }
+    }
+
     REPORT_ERROR;
     return ERROR_CODE;
 }
@@ -0,0 +1,325 @@
+#include "sim/AtlasSim.hpp"
+
+#include "core/AtlasState.hpp"
+#include "core/Fetch.hpp"
+
+#include "sparta/simulation/Parameter.hpp"
+#include "sparta/statistics/CounterBase.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+class BasicBlockTester
+{
+  public:
+    // Fetch parameters to override, by name
+    BasicBlockTester(const std::map<std::string, std::string> & fetch_params = {})
+    {
+        // Create the simulator
+        const uint64_t ilimit = 0;
+        atlas_sim_.reset(new atlas::AtlasSim(&scheduler_, {}, {}, ilimit));
+
+        atlas_sim_->buildTree();
+        for (const auto & [name, value] : fetch_params)
+        {
+            atlas_sim_->getRoot()
+                ->getChildAs<sparta::ParameterBase>("core0.fetch.params." + name)
+                ->setValueFromString(value);
+        }
+        atlas_sim_->configureTree();
+        atlas_sim_->finalizeTree();
+
+        state_ = atlas_sim_->getAtlasState();
+        fetch_unit_ = state_->getFetchUnit();
+    }
+
+    void testSelfModifyingCode()
+    {
+        std::cout << "Testing stores to cached basic blocks" << std::endl;
+
+        // Loop: addi x5, x5, 1; jal x0, -4
+        const atlas::Addr pc = 0x1000;
+        const uint32_t ADDI_X5_X5_1 = 0x00128293;
+        const uint32_t ADDI_X5_X5_2 = 0x00228293;
+        const uint32_t JAL_X0_M4 = 0xffdff06f;
+        state_->writeMemory<uint32_t>(pc, ADDI_X5_X5_1);
+        state_->writeMemory<uint32_t>(pc + 4, JAL_X0_M4);
+
+        atlas::WRITE_INT_REG<atlas::RV64>(state_, 5, 0);
+        state_->setPc(pc);
+        fetch_unit_->runQuantum(20);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 10);
+        EXPECT_EQUAL(state_->getPc(), pc);
+        EXPECT_TRUE(getFetchCounter_("basic_blocks_executed") > 0);
+
+        // Overwriting the addi invalidates the cached block
+        const uint64_t num_blocks_executed = getFetchCounter_("basic_blocks_executed");
+        state_->writeMemory<uint32_t>(pc, ADDI_X5_X5_2);
+        EXPECT_EQUAL(getFetchCounter_("code_page_invalidations"), 0);
+        fetch_unit_->runQuantum(20);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 30);
+        EXPECT_EQUAL(getFetchCounter_("code_page_invalidations"), 1);
+
+        // The modified block is cached again
+        EXPECT_TRUE(getFetchCounter_("basic_blocks_executed") > num_blocks_executed);
+
+        // Stores to other pages do not invalidate anything
+        state_->writeMemory<uint32_t>(pc + 0x1000, ADDI_X5_X5_1);
+        fetch_unit_->runQuantum(20);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 50);
+        EXPECT_EQUAL(getFetchCounter_("code_page_invalidations"), 1);
+    }
+
+    void testBlockExecutionDisabled()
+    {
+        std::cout << "Testing execution without basic blocks" << std::endl;
+
+        // Loop: addi x5, x5, 1; jal x0, -4
+        const atlas::Addr pc = 0x1000;
+        state_->writeMemory<uint32_t>(pc, 0x00128293);
+        state_->writeMemory<uint32_t>(pc + 4, 0xffdff06f);
+
+        atlas::WRITE_INT_REG<atlas::RV64>(state_, 5, 0);
+        state_->setPc(pc);
+        fetch_unit_->runQuantum(100);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 50);
+        EXPECT_EQUAL(state_->getPc(), pc);
+
+        // Every instruction is interpreted, no blocks are recorded
+        EXPECT_EQUAL(getFetchCounter_("basic_blocks_created"), 0);
+        EXPECT_EQUAL(getFetchCounter_("basic_blocks_executed"), 0);
+        EXPECT_EQUAL(getFetchCounter_("block_insts"), 0);
+        EXPECT_EQUAL(getFetchCounter_("interpreted_insts"), 100);
+    }
+
+    void testBlockEviction(const uint32_t block_cache_capacity)
+    {
+        std::cout << "Testing eviction of cold basic blocks" << std::endl;
+
+        // Hot loop: addi x5, x5, 1; jal x0, -4
+        const atlas::Addr hot_pc = 0x1000;
+        state_->writeMemory<uint32_t>(hot_pc, 0x00128293);
+        state_->writeMemory<uint32_t>(hot_pc + 4, 0xffdff06f);
+
+        atlas::WRITE_INT_REG<atlas::RV64>(state_, 5, 0);
+        state_->setPc(hot_pc);
+        fetch_unit_->runQuantum(2000);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 1000);
+        EXPECT_EQUAL(getFetchCounter_("basic_blocks_created"), 1);
+        EXPECT_EQUAL(getFetchCounter_("basic_blocks_evicted"), 0);
+
+        // Loop through more cold blocks than fit in the cache, one block every 64B:
+        // addi x6, x6, 1; jal x0, +0x3c. The last block jumps back to the first one.
+        const atlas::Addr cold_pc = 0x2000;
+        const uint32_t num_cold_blocks = 8;
+        for (uint32_t idx = 0; idx < num_cold_blocks; ++idx)
+        {
+            const atlas::Addr block_pc = cold_pc + idx * 0x40;
+            const bool last_block = (idx == (num_cold_blocks - 1));
+            state_->writeMemory<uint32_t>(block_pc, 0x00130313);
+            state_->writeMemory<uint32_t>(block_pc + 4, last_block ? 0xe3dff06f : 0x03c0006f);
+        }
+
+        // Every cold block is cached on its second pass
+        atlas::WRITE_INT_REG<atlas::RV64>(state_, 6, 0);
+        state_->setPc(cold_pc);
+        fetch_unit_->runQuantum(2 * num_cold_blocks * 2);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 6), 2 * num_cold_blocks);
+
+        // The cache is allowed to exceed its capacity by one block until the next lookup
+        const uint64_t num_blocks_created = getFetchCounter_("basic_blocks_created");
+        const uint64_t num_blocks_evicted = getFetchCounter_("basic_blocks_evicted");
+        EXPECT_TRUE(num_blocks_evicted > 0);
+        EXPECT_TRUE((num_blocks_created - num_blocks_evicted) <= (block_cache_capacity + 1));
+
+        // The hot block was kept, so it executes from the cache on every pass
+        const uint64_t num_blocks_executed = getFetchCounter_("basic_blocks_executed");
+        state_->setPc(hot_pc);
+        fetch_unit_->runQuantum(20);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 1010);
+        EXPECT_EQUAL(getFetchCounter_("basic_blocks_executed"), num_blocks_executed + 10);
+    }
+
+    void testFusedInsts()
+    {
+        std::cout << "Testing fused instruction pairs" << std::endl;
+
+        // Data for the fused loads, on a different page than the code
+        state_->writeMemory<uint64_t>(0x8800, 0x0123456789abcdef);
+        state_->writeMemory<uint32_t>(0x8808, 0x80000001);
+        state_->writeMemory<uint16_t>(0x8810, 0x8001);
+        state_->writeMemory<uint64_t>(0x8ff8, 0x1122334455667788);
+        state_->writeMemory<uint64_t>(0x9000, 0x99aabbccddeeff00);
+
+        const uint32_t JAL_X0_0 = 0x0000006f;
+
+        // lui x5, 0x12345; addi x6, x5, 0x678
+        testFusedPair_("lui+addi", 0x4000, {0x123452b7, 0x67828313, JAL_X0_0}, {});
+        // lui x5, 0x80000; addi x6, x5, -1
+        testFusedPair_("lui+addi (negative)", 0x4040, {0x800002b7, 0xfff28313, JAL_X0_0}, {});
+        // lui x5, 0x80000; addiw x6, x5, -1
+        testFusedPair_("lui+addiw", 0x4080, {0x800002b7, 0xfff2831b, JAL_X0_0}, {});
+        // auipc x5, 0x1; jalr x1, 0x10(x5)
+        testFusedPair_("auipc+jalr", 0x40c0, {0x00001297, 0x010280e7}, {});
+        // auipc x5, 0x0; jalr x5, 0x20(x5)
+        testFusedPair_("auipc+jalr (rd == rs1)", 0x4100, {0x00000297, 0x020282e7}, {});
+        // auipc x5, 0x0; jalr x1, 0x12(x5), could trap without compressed instructions
+        const uint32_t not_fused = 0;
+        testFusedPair_("auipc+jalr (2B aligned target)", 0x42c0, {0x00000297, 0x012280e7}, {},
+                       not_fused);
+        // slli x5, x6, 32; srli x7, x5, 32
+        testFusedPair_("slli+srli", 0x4140, {0x02031293, 0x0202d393, JAL_X0_0},
+                       {{6, 0xdeadbeefcafef00d}});
+        // auipc x5, 0x4; ld x6, 0x680(x5)
+        testFusedPair_("auipc+ld", 0x4180, {0x00004297, 0x6802b303, JAL_X0_0}, {});
+        // auipc x5, 0x4; lw x6, 0x648(x5)
+        testFusedPair_("auipc+lw", 0x41c0, {0x00004297, 0x6482a303, JAL_X0_0}, {});
+        // auipc x5, 0x5; ld x6, -0x204(x5)
+        testFusedPair_("auipc+ld (page crossing)", 0x4200, {0x00005297, 0xdfc2b303, JAL_X0_0},
+                       {});
+        // add x5, x6, x7; lh x8, 0(x5)
+        testFusedPair_("add+lh", 0x4240, {0x007302b3, 0x00029403, JAL_X0_0},
+                       {{6, 0x8000}, {7, 0x810}});
+        // add x5, x6, x7; ld x8, 0(x5)
+        testFusedPair_("add+ld (page crossing)", 0x4280, {0x007302b3, 0x0002b403, JAL_X0_0},
+                       {{6, 0x8000}, {7, 0xffc}});
+    }
+
+  private:
+    // Executes the block at pc once per pass. The first passes are interpreted, the block is
+    // cached and its first two instructions are fused from the third pass onward. The fused pass
+    // must leave the same registers, PC and instruction count as the interpreted pass. Nothing is
+    // fused if fusion is disabled, but the cached pass must still match.
+    void testFusedPair_(const std::string & name, const atlas::Addr pc,
+                        const std::vector<uint32_t> & opcodes,
+                        const std::map<uint32_t, uint64_t> & init_regs,
+                        const uint32_t num_fused_pairs = 1)
+    {
+        std::cout << "  " << name << std::endl;
+
+        for (size_t idx = 0; idx < opcodes.size(); ++idx)
+        {
+            state_->writeMemory<uint32_t>(pc + idx * 4, opcodes[idx]);
+        }
+
+        const uint64_t num_fused_inst_pairs = getFetchCounter_("fused_inst_pairs");
+        std::array<uint64_t, 32> interpreted_regs{};
+        atlas::Addr interpreted_pc = 0;
+        uint64_t interpreted_num_insts = 0;
+
+        const uint32_t num_passes = 3;
+        for (uint32_t pass = 0; pass < num_passes; ++pass)
+        {
+            for (uint32_t reg = 1; reg < 32; ++reg)
+            {
+                const auto it = init_regs.find(reg);
+                atlas::WRITE_INT_REG<atlas::RV64>(state_, reg,
+                                                  (it != init_regs.end()) ? it->second : 0);
+            }
+            state_->setPc(pc);
+
+            const uint64_t inst_count = state_->getSimState()->inst_count;
+            const uint64_t num_blocks_executed = getFetchCounter_("basic_blocks_executed");
+            fetch_unit_->runQuantum(opcodes.size());
+
+            std::array<uint64_t, 32> regs{};
+            for (uint32_t reg = 1; reg < 32; ++reg)
+            {
+                regs[reg] = atlas::READ_INT_REG<atlas::RV64>(state_, reg);
+            }
+            const uint64_t num_insts = state_->getSimState()->inst_count - inst_count;
+
+            if (pass == 0)
+            {
+                interpreted_regs = regs;
+                interpreted_pc = state_->getPc();
+                interpreted_num_insts = num_insts;
+                EXPECT_EQUAL(num_insts, opcodes.size());
+                EXPECT_EQUAL(getFetchCounter_("basic_blocks_executed"), num_blocks_executed);
+            }
+            else if (pass == (num_passes - 1))
+            {
+                EXPECT_EQUAL(getFetchCounter_("basic_blocks_executed"), num_blocks_executed + 1);
+                for (uint32_t reg = 1; reg < 32; ++reg)
+                {
+                    EXPECT_EQUAL(regs[reg], interpreted_regs[reg]);
+                }
+                EXPECT_EQUAL(state_->getPc(), interpreted_pc);
+                EXPECT_EQUAL(num_insts, interpreted_num_insts);
+            }
+        }
+
+        const uint32_t expected_fused_pairs = isFusionEnabled_() ? num_fused_pairs : 0;
+        EXPECT_EQUAL(getFetchCounter_("fused_inst_pairs"),
+                     num_fused_inst_pairs + expected_fused_pairs);
+    }
+
+    bool isFusionEnabled_() const
+    {
+        return atlas_sim_->getRoot()
+            ->getChildAs<sparta::ParameterBase>("core0.fetch.params.enable_fusion")
+            ->getValueAs<bool>();
+    }
+
+    uint64_t getFetchCounter_(const std::string & name) const
+    {
+        return atlas_sim_->getRoot()
+            ->getChildAs<sparta::CounterBase>("core0.fetch.stats." + name)
+            ->get();
+    }
+
+    sparta::Scheduler scheduler_;
+    std::unique_ptr<atlas::AtlasSim> atlas_sim_;
+
+    atlas::AtlasState* state_ = nullptr;
+    atlas::Fetch* fetch_unit_ = nullptr;
+};
+
+int main(int argc, char** argv)
+{
+    const std::string mode = (argc > 1) ? argv[1] : "";
+
+    if (mode == "no_block")
+    {
+        BasicBlockTester tester({{"enable_block_execution", "false"}});
+        tester.testBlockExecutionDisabled();
+    }
+    else if (mode == "block_eviction")
+    {
+        const uint32_t block_cache_capacity = 4;
+        BasicBlockTester tester(
+            {{"block_cache_capacity", std::to_string(block_cache_capacity)}});
+        tester.testBlockEviction(block_cache_capacity);
+    }
+    else if (mode == "no_fusion")
+    {
+        BasicBlockTester tester({{"enable_fusion", "false"}});
+        tester.testFusedInsts();
+    }
+    else if (mode == "threaded")
+    {
+        // Blocks and the interpreter must give the same results with threaded dispatch
+        {
+            BasicBlockTester tester({{"enable_threaded_dispatch", "true"}});
+            tester.testSelfModifyingCode();
+            tester.testFusedInsts();
+        }
+        {
+            BasicBlockTester tester(
+                {{"enable_threaded_dispatch", "true"}, {"enable_block_execution", "false"}});
+            tester.testBlockExecutionDisabled();
+        }
+    }
+    else
+    {
+        BasicBlockTester tester;
+        tester.testSelfModifyingCode();
+        tester.testFusedInsts();
+    }
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
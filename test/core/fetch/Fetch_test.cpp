@@ -53,6 +53,55 @@ class FetchTester
 
     ~FetchTester() { root_tn_.enterTeardown(); }
 
+    void testDecodeCache()
+    {
+        atlas::DecodeCache decode_cache(16);
+        const atlas::Addr paddr = 0x1000;
+        const uint32_t context_id = state_->getMavisContextId();
+        EXPECT_TRUE(decode_cache.lookup(paddr, atlas::NOP_OPCODE, context_id) == nullptr);
+
+        atlas::AtlasInstPtr inst = state_->getMavis()->makeInst(atlas::NOP_OPCODE, state_.get());
+        decode_cache.allocate(paddr, atlas::NOP_OPCODE, context_id, inst);
+        EXPECT_TRUE(decode_cache.lookup(paddr, atlas::NOP_OPCODE, context_id) == inst);
+
+        // Different opcode, physical address or Mavis context must miss
+        EXPECT_TRUE(decode_cache.lookup(paddr, atlas::WFI_OPCODE, context_id) == nullptr);
+        EXPECT_TRUE(decode_cache.lookup(paddr + 16 * 2, atlas::NOP_OPCODE, context_id) == nullptr);
+        EXPECT_TRUE(decode_cache.lookup(paddr, atlas::NOP_OPCODE, context_id + 1) == nullptr);
+
+        decode_cache.invalidate();
+        EXPECT_TRUE(decode_cache.lookup(paddr, atlas::NOP_OPCODE, context_id) == nullptr);
+
+        EXPECT_THROW(atlas::DecodeCache(12));
+    }
+
+    void testLinkInst()
+    {
+        const uint64_t LD_OPCODE = 0x00013083; // ld x1, 0(x2)
+        atlas::AtlasInstPtr inst = state_->getMavis()->makeInst(LD_OPCODE, state_.get());
+        const size_t num_mavis_actions = inst->getActionGroup()->getActions().size();
+        EXPECT_FALSE(inst->isLinked(state_->getLinkId()));
+
+        // Without observers, instructions retire themselves and go straight back to Fetch
+        EXPECT_TRUE(state_->isFastCore());
+        EXPECT_TRUE(state_->getInstNextActionGroup() == fetch_->getActionGroup());
+
+        // Linking inserts the load translate Actions
+        atlas::Execute* execute_unit = state_->getExecuteUnit();
+        execute_unit->linkInst(state_.get(), inst);
+        EXPECT_TRUE(inst->isLinked(state_->getLinkId()));
+        const size_t num_linked_actions = inst->getActionGroup()->getActions().size();
+        EXPECT_TRUE(num_linked_actions > num_mavis_actions);
+
+        // Relinking starts over from the Mavis Actions
+        execute_unit->linkInst(state_.get(), inst);
+        EXPECT_EQUAL(inst->getActionGroup()->getActions().size(), num_linked_actions);
+
+        inst->unlink();
+        EXPECT_FALSE(inst->isLinked(state_->getLinkId()));
+        EXPECT_EQUAL(inst->getActionGroup()->getActions().size(), num_mavis_actions);
+    }
+
   private:
     // Sparta components
     sparta::Scheduler scheduler_;
@@ -82,6 +131,8 @@ int main(int argc, char** argv)
     (void)argv;
 
     FetchTester tester;
+    tester.testDecodeCache();
+    tester.testLinkInst();
 
     REPORT_ERROR;
     return ERROR_CODE;
@@ -0,0 +1,246 @@
+#include "sim/AtlasSim.hpp"
+
+#include "core/AtlasState.hpp"
+#include "system/AtlasSystem.hpp"
+
+#include "elfio/elfio.hpp"
+
+#include "sparta/memory/SimpleMemoryMapNode.hpp"
+#include "sparta/simulation/Parameter.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+class MemoryTester
+{
+  public:
+    // System parameters to override, by name
+    MemoryTester(const std::map<std::string, std::string> & system_params = {},
+                 const atlas::AtlasSim::WorkloadAndArguments & workload_and_args = {})
+    {
+        // Create the simulator
+        const uint64_t ilimit = 0;
+        atlas_sim_.reset(new atlas::AtlasSim(&scheduler_, workload_and_args, {}, ilimit));
+
+        atlas_sim_->buildTree();
+        for (const auto & [name, value] : system_params)
+        {
+            atlas_sim_->getRoot()
+                ->getChildAs<sparta::ParameterBase>("system.params." + name)
+                ->setValueFromString(value);
+        }
+        atlas_sim_->configureTree();
+        atlas_sim_->finalizeTree();
+
+        state_ = atlas_sim_->getAtlasState();
+    }
+
+    void testHostAccess()
+    {
+        std::cout << "Testing host pointer access to memory" << std::endl;
+
+        // Ordinary memory is accessed through host pointers unless host access is disabled
+        const bool host_access = getSystemParam_<bool>("enable_dram_host_access");
+        uint8_t* host_ptr = state_->getHostMemory(0x8000, sizeof(uint64_t));
+        EXPECT_EQUAL(host_ptr != nullptr, host_access);
+
+        // Accesses crossing a memory block and device accesses always go through the memory map
+        EXPECT_TRUE(state_->getHostMemory(0x8ffc, sizeof(uint64_t)) == nullptr);
+        const atlas::Addr uart_addr = 0x20000000;
+        EXPECT_TRUE(state_->getHostMemory(uart_addr, sizeof(uint32_t)) == nullptr);
+
+        // Stores through either path are seen by the other one
+        state_->writeMemory<uint64_t>(0x8000, 0x0123456789abcdef);
+        EXPECT_EQUAL(peekMemory_<uint64_t>(0x8000), 0x0123456789abcdef);
+        if (host_ptr)
+        {
+            const uint64_t value = 0x1122334455667788;
+            std::memcpy(host_ptr, &value, sizeof(value));
+            EXPECT_EQUAL(state_->readMemory<uint64_t>(0x8000), value);
+            EXPECT_EQUAL(peekMemory_<uint64_t>(0x8000), value);
+        }
+
+        state_->writeMemory<uint64_t>(0x8ffc, 0x99aabbccddeeff00);
+        EXPECT_EQUAL(state_->readMemory<uint64_t>(0x8ffc), 0x99aabbccddeeff00);
+        EXPECT_EQUAL(peekMemory_<uint32_t>(0x9000), 0x99aabbcc);
+    }
+
+    void testSparseMemory()
+    {
+        std::cout << "Testing sparse memory" << std::endl;
+
+        const uint64_t sparse_memory_size = getSystemParam_<uint64_t>("sparse_memory_size");
+        const atlas::Addr block_size = atlas::AtlasSystem::ATLAS_SYSTEM_BLOCK_SIZE;
+        const atlas::Addr paddr = 0x800000000;
+        if (sparse_memory_size > 0)
+        {
+            // Sparse memory is a single host reservation, consecutive blocks are contiguous
+            EXPECT_TRUE(state_->getHostMemory(paddr + block_size, 1)
+                        == (state_->getHostMemory(paddr, 1) + block_size));
+
+            // Host pages are only committed once they are written. The other address is outside
+            // of any huge page holding paddr.
+            const atlas::Addr other_paddr = paddr + 0x400000;
+            EXPECT_FALSE(isHostPageResident_(paddr));
+            EXPECT_FALSE(isHostPageResident_(other_paddr));
+            state_->writeMemory<uint64_t>(paddr, 0x0123456789abcdef);
+            EXPECT_TRUE(isHostPageResident_(paddr));
+            EXPECT_FALSE(isHostPageResident_(other_paddr));
+        }
+        else
+        {
+            // Memory objects allocate blocks on first access
+            state_->writeMemory<uint64_t>(paddr, 0x0123456789abcdef);
+        }
+        EXPECT_EQUAL(state_->readMemory<uint64_t>(paddr), 0x0123456789abcdef);
+        EXPECT_EQUAL(peekMemory_<uint64_t>(paddr), 0x0123456789abcdef);
+
+        // Memory above sparse memory uses memory objects
+        const atlas::Addr high_paddr = sparse_memory_size + block_size;
+        EXPECT_TRUE(state_->getHostMemory(high_paddr, 1) != nullptr);
+        state_->writeMemory<uint64_t>(high_paddr, 0xfedcba9876543210);
+        EXPECT_EQUAL(state_->readMemory<uint64_t>(high_paddr), 0xfedcba9876543210);
+        EXPECT_EQUAL(peekMemory_<uint64_t>(high_paddr), 0xfedcba9876543210);
+    }
+
+    void testElfMmap(const std::string & workload)
+    {
+        std::cout << "Testing copy-on-write mapping of ELF segments" << std::endl;
+
+        // First whole host page of a segment, only whole pages are mapped
+        ELFIO::elfio elf_reader;
+        EXPECT_TRUE(elf_reader.load(workload));
+        const uint64_t host_page_size = ::sysconf(_SC_PAGESIZE);
+        atlas::Addr paddr = 0;
+        uint64_t file_offset = 0;
+        uint64_t elf_value = 0;
+        for (const auto & segment : elf_reader.segments)
+        {
+            const atlas::Addr start = segment->get_physical_address();
+            const atlas::Addr page = (start + host_page_size - 1) & ~(host_page_size - 1);
+            if ((segment->get_type() == ELFIO::PT_LOAD)
+                && ((page + host_page_size) <= (start + segment->get_file_size())))
+            {
+                paddr = page;
+                file_offset = segment->get_offset() + (page - start);
+                std::memcpy(&elf_value, segment->get_data() + (page - start), sizeof(elf_value));
+                break;
+            }
+        }
+        EXPECT_NOTEQUAL(paddr, 0);
+        EXPECT_EQUAL(state_->readMemory<uint64_t>(paddr), elf_value);
+
+        // The workload is mapped into sparse memory unless ELF mapping is disabled
+        const bool elf_mmap = getSystemParam_<bool>("enable_elf_mmap");
+        EXPECT_EQUAL(isFileMapped_(workload), elf_mmap);
+
+        // Stores change memory but are never written back to the workload
+        state_->writeMemory<uint64_t>(paddr, ~elf_value);
+        EXPECT_EQUAL(state_->readMemory<uint64_t>(paddr), ~elf_value);
+        EXPECT_EQUAL(peekMemory_<uint64_t>(paddr), ~elf_value);
+
+        std::ifstream workload_file(workload, std::ios::binary);
+        uint64_t file_value = 0;
+        workload_file.seekg(file_offset);
+        workload_file.read(reinterpret_cast<char*>(&file_value), sizeof(file_value));
+        EXPECT_TRUE(workload_file.good());
+        EXPECT_EQUAL(file_value, elf_value);
+    }
+
+  private:
+    // Does this process have a host mapping of the file?
+    static bool isFileMapped_(const std::string & file_name)
+    {
+        const std::string real_path = std::filesystem::canonical(file_name).string();
+        std::ifstream maps("/proc/self/maps");
+        std::string line;
+        while (std::getline(maps, line))
+        {
+            if (line.ends_with(" " + real_path))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Is the host page holding paddr backed by host memory? paddr must be in sparse memory.
+    bool isHostPageResident_(const atlas::Addr paddr)
+    {
+        const uintptr_t host_page_size = ::sysconf(_SC_PAGESIZE);
+        const uintptr_t host_addr = reinterpret_cast<uintptr_t>(state_->getHostMemory(paddr, 1));
+        unsigned char resident = 0;
+        const int ret =
+            ::mincore(reinterpret_cast<void*>(host_addr & ~(host_page_size - 1)), 1, &resident);
+        EXPECT_EQUAL(ret, 0);
+        return (resident & 1) != 0;
+    }
+
+    template <typename T> T getSystemParam_(const std::string & name) const
+    {
+        return atlas_sim_->getRoot()
+            ->getChildAs<sparta::ParameterBase>("system.params." + name)
+            ->getValueAs<T>();
+    }
+
+    // Read memory through the memory map without going through AtlasState
+    template <typename MemoryType> MemoryType peekMemory_(const atlas::Addr paddr) const
+    {
+        MemoryType value = 0;
+        const bool success = atlas_sim_->getAtlasSystem()->getSystemMemory()->tryPeek(
+            paddr, sizeof(value), reinterpret_cast<uint8_t*>(&value));
+        EXPECT_TRUE(success);
+        return value;
+    }
+
+    sparta::Scheduler scheduler_;
+    std::unique_ptr<atlas::AtlasSim> atlas_sim_;
+
+    atlas::AtlasState* state_ = nullptr;
+};
+
+int main(int argc, char** argv)
+{
+    const std::string mode = (argc > 1) ? argv[1] : "";
+
+    if (mode == "no_dram_host_access")
+    {
+        MemoryTester tester({{"enable_dram_host_access", "false"}, {"enable_uart", "true"}});
+        tester.testHostAccess();
+    }
+    else if (mode == "no_sparse_memory")
+    {
+        MemoryTester tester({{"sparse_memory_size", "0"}, {"enable_uart", "true"}});
+        tester.testHostAccess();
+        tester.testSparseMemory();
+    }
+    else if ((mode == "elf_mmap") || (mode == "no_elf_mmap"))
+    {
+        const std::string workload = "workloads/dhry.elf";
+        MemoryTester tester({{"enable_elf_mmap", (mode == "elf_mmap") ? "true" : "false"}},
+                            {workload});
+        tester.testElfMmap(workload);
+    }
+    else if (mode == "sparse_memory_huge_pages")
+    {
+        // Huge pages are only a hint, the host may still commit base pages
+        MemoryTester tester({{"sparse_memory_huge_pages", "true"}});
+        tester.testSparseMemory();
+    }
+    else
+    {
+        MemoryTester tester({{"enable_uart", "true"}});
+        tester.testHostAccess();
+        tester.testSparseMemory();
+    }
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
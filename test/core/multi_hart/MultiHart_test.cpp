@@ -0,0 +1,444 @@
+#include "sim/AtlasSim.hpp"
+
+#include "core/AtlasState.hpp"
+#include "core/Fetch.hpp"
+
+#include "sparta/simulation/Parameter.hpp"
+#include "sparta/statistics/CounterBase.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+#include <string>
+#include <vector>
+
+class MultiHartTester
+{
+  public:
+    MultiHartTester(const uint64_t ilimit = 0, const uint64_t quantum = 3,
+                    const bool parallel_harts = false, const bool stop_sim_on_wfi = false)
+    {
+        // Create the simulator
+        atlas_sim_.reset(new atlas::AtlasSim(&scheduler_, {}, {}, ilimit, NUM_HARTS, quantum,
+                                             parallel_harts));
+
+        atlas_sim_->buildTree();
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getRoot()
+                ->getChildAs<sparta::ParameterBase>("core" + std::to_string(hart_id)
+                                                    + ".params.stop_sim_on_wfi")
+                ->setValueFromString(stop_sim_on_wfi ? "true" : "false");
+        }
+        atlas_sim_->configureTree();
+        atlas_sim_->finalizeTree();
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->boot();
+        }
+    }
+
+    void testHartIds()
+    {
+        std::cout << "Testing mhartid dependent stores" << std::endl;
+
+        // Every hart runs the same code and stores 0x100 + mhartid to 0x8000 + mhartid * 8
+        const atlas::Addr pc = 0x1000;
+        const std::vector<uint32_t> opcodes = {
+            0xf14022f3, // csrr x5, mhartid
+            0x00329313, // slli x6, x5, 3
+            0x00008e37, // lui x28, 0x8
+            0x006e0e33, // add x28, x28, x6
+            0x10028393, // addi x7, x5, 0x100
+            0x007e3023, // sd x7, 0(x28)
+            0x0000006f  // jal x0, 0
+        };
+        atlas::AtlasState* state = atlas_sim_->getAtlasState(0);
+        for (size_t idx = 0; idx < opcodes.size(); ++idx)
+        {
+            state->writeMemory<uint32_t>(pc + idx * 4, opcodes[idx]);
+        }
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->setPc(pc);
+        }
+
+        // Interleave the harts in quanta that end in the middle of the code
+        const uint64_t quantum = 3;
+        for (uint32_t round = 0; round < 4; ++round)
+        {
+            for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+            {
+                atlas_sim_->getAtlasState(hart_id)->getFetchUnit()->runQuantum(quantum);
+            }
+        }
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas::AtlasState* hart_state = atlas_sim_->getAtlasState(hart_id);
+            EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(hart_state, 5), hart_id);
+            EXPECT_EQUAL(state->readMemory<uint64_t>(0x8000 + hart_id * 8), 0x100 + hart_id);
+            EXPECT_EQUAL(hart_state->getPc(), pc + (opcodes.size() - 1) * 4);
+        }
+    }
+
+    void testLrScReservation()
+    {
+        std::cout << "Testing LR/SC reservations broken by another hart" << std::endl;
+
+        // Hart 0 loads the word at 0x8000 with LR and stores 5 with SC, twice. Hart 1 stores 1
+        // and then 0 to the word, so it holds the value loaded by the first LR again.
+        const atlas::Addr pc = 0x1000;
+        const atlas::Addr paddr = 0x8000;
+        const std::vector<uint32_t> opcodes = {
+            0xf14022f3, // csrr x5, mhartid
+            0x000083b7, // lui x7, 0x8
+            0x00029e63, // bne x5, x0, +28
+            0x1003b52f, // lr.d x10, (x7)
+            0x00500593, // addi x11, x0, 5
+            0x18b3b62f, // sc.d x12, x11, (x7)
+            0x1003b52f, // lr.d x10, (x7)
+            0x18b3b6af, // sc.d x13, x11, (x7)
+            0x0000006f, // jal x0, 0
+            0x00100593, // addi x11, x0, 1
+            0x00b3b023, // sd x11, 0(x7)
+            0x0003b023, // sd x0, 0(x7)
+            0x0000006f  // jal x0, 0
+        };
+        atlas::AtlasState* state = atlas_sim_->getAtlasState(0);
+        for (size_t idx = 0; idx < opcodes.size(); ++idx)
+        {
+            state->writeMemory<uint32_t>(pc + idx * 4, opcodes[idx]);
+        }
+        state->writeMemory<uint64_t>(paddr, 0);
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->setPc(pc);
+        }
+
+        // Hart 0 runs up to and including the first LR, then hart 1 runs its stores
+        atlas::Fetch* hart0_fetch = atlas_sim_->getAtlasState(0)->getFetchUnit();
+        atlas::Fetch* hart1_fetch = atlas_sim_->getAtlasState(1)->getFetchUnit();
+        hart0_fetch->runQuantum(4);
+        hart1_fetch->runQuantum(6);
+        EXPECT_EQUAL(state->readMemory<uint64_t>(paddr), 0);
+
+        // The first SC fails even though memory holds the loaded value, the second one succeeds
+        hart0_fetch->runQuantum(4);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state, 12), 1);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state, 13), 0);
+        EXPECT_EQUAL(state->readMemory<uint64_t>(paddr), 5);
+        EXPECT_FALSE(state->getReservationTable()->isAnyReservationActive());
+    }
+
+    void testStopOnWfi()
+    {
+        std::cout << "Testing harts stopping at different times" << std::endl;
+
+        // Every hart counts to 64 * (mhartid + 1) in x6 and then stops with a WFI
+        const atlas::Addr pc = 0x1000;
+        const std::vector<uint32_t> opcodes = {
+            0xf14022f3, // csrr x5, mhartid
+            0x00128e13, // addi x28, x5, 1
+            0x006e1e13, // slli x28, x28, 6
+            0x00130313, // addi x6, x6, 1
+            0xfffe0e13, // addi x28, x28, -1
+            0xfe0e1ce3, // bne x28, x0, -8
+            0x10500073, // wfi
+            0x0000006f  // jal x0, 0
+        };
+        atlas::AtlasState* state = atlas_sim_->getAtlasState(0);
+        for (size_t idx = 0; idx < opcodes.size(); ++idx)
+        {
+            state->writeMemory<uint32_t>(pc + idx * 4, opcodes[idx]);
+        }
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->setPc(pc);
+        }
+
+        // Returns once the last hart has stopped, the harts that stopped earlier are not run
+        // again (and no longer wait for the others at the end of each quantum)
+        atlas_sim_->runHarts_();
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas::AtlasState* hart_state = atlas_sim_->getAtlasState(hart_id);
+            const uint64_t num_iterations = 64 * (hart_id + 1);
+            const uint64_t num_insts = 3 + 3 * num_iterations;
+            EXPECT_TRUE(hart_state->getSimState()->sim_stopped);
+            EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(hart_state, 6), num_iterations);
+            EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(hart_state, 28), 0);
+
+            // Up to and possibly including the WFI
+            EXPECT_TRUE(hart_state->getSimState()->inst_count >= num_insts);
+            EXPECT_TRUE(hart_state->getSimState()->inst_count <= (num_insts + 1));
+        }
+    }
+
+    void testFenceI()
+    {
+        std::cout << "Testing fence.i after another hart modified cached code" << std::endl;
+
+        // Loop: addi x6, x6, 1; jal x0, -4
+        const atlas::Addr loop_pc = 0x1000;
+        const uint32_t ADDI_X6_X6_2 = 0x00230313;
+        atlas::AtlasState* hart0_state = atlas_sim_->getAtlasState(0);
+        hart0_state->writeMemory<uint32_t>(loop_pc, 0x00130313);
+        hart0_state->writeMemory<uint32_t>(loop_pc + 4, 0xffdff06f);
+
+        // fence.i; jal x0, -0x104 (back to the loop)
+        const atlas::Addr fence_i_pc = 0x1100;
+        hart0_state->writeMemory<uint32_t>(fence_i_pc, 0x0000100f);
+        hart0_state->writeMemory<uint32_t>(fence_i_pc + 4, 0xefdff06f);
+
+        // Hart 0 caches the loop as a basic block
+        atlas::Fetch* hart0_fetch = hart0_state->getFetchUnit();
+        hart0_state->setPc(loop_pc);
+        hart0_fetch->runQuantum(20);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(hart0_state, 6), 10);
+        EXPECT_TRUE(getHart0Counter_("basic_blocks_executed") > 0);
+
+        // Stores by hart 1 only invalidate hart 1's blocks, hart 0 sees the new code once it
+        // executes a fence.i
+        atlas_sim_->getAtlasState(1)->writeMemory<uint32_t>(loop_pc, ADDI_X6_X6_2);
+        hart0_state->setPc(fence_i_pc);
+        hart0_fetch->runQuantum(2 + 20);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(hart0_state, 6), 10 + 2 * 10);
+    }
+
+    void testInstLimit(const uint64_t ilimit)
+    {
+        std::cout << "Testing the per-hart instruction limit" << std::endl;
+
+        // Every hart counts loop iterations in x5 until it is stopped by the limit
+        const atlas::Addr pc = 0x1000;
+        atlas::AtlasState* state = atlas_sim_->getAtlasState(0);
+        state->writeMemory<uint32_t>(pc, 0x00128293);     // addi x5, x5, 1
+        state->writeMemory<uint32_t>(pc + 4, 0xffdff06f); // jal x0, -4
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->setPc(pc);
+        }
+
+        atlas_sim_->runHarts_();
+
+        // The limit is odd so it is reached in the middle of a cached basic block
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas::AtlasState* hart_state = atlas_sim_->getAtlasState(hart_id);
+            const atlas::AtlasState::SimState* sim_state = hart_state->getSimState();
+            EXPECT_TRUE(sim_state->sim_stopped);
+            EXPECT_EQUAL(sim_state->inst_count, ilimit);
+            EXPECT_EQUAL(sim_state->workload_exit_code, atlas::AtlasSim::INST_LIMIT_EXIT_CODE);
+            EXPECT_FALSE(sim_state->test_passed);
+            EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(hart_state, 5), (ilimit + 1) / 2);
+            EXPECT_EQUAL(hart_state->getPc(), pc + 4);
+        }
+    }
+
+    void testAtomicCounter(const uint64_t ilimit, const uint32_t num_iterations)
+    {
+        std::cout << "Testing an atomic counter shared by the harts" << std::endl;
+
+        // Every hart adds 1 to the counter at 0x8000 num_iterations times and then spins until
+        // it is stopped by the instruction limit
+        const atlas::Addr pc = 0x1000;
+        const atlas::Addr counter_paddr = 0x8000;
+        const std::vector<uint32_t> opcodes = {
+            0x000083b7,                         // lui x7, 0x8
+            0x00100313,                         // addi x6, x0, 1
+            0x00000e13 | (num_iterations << 20), // addi x28, x0, num_iterations
+            0x0063b02f,                         // amoadd.d x0, x6, (x7)
+            0xfffe0e13,                         // addi x28, x28, -1
+            0xfe0e1ce3,                         // bne x28, x0, -8
+            0x0000006f                          // jal x0, 0
+        };
+        atlas::AtlasState* state = atlas_sim_->getAtlasState(0);
+        for (size_t idx = 0; idx < opcodes.size(); ++idx)
+        {
+            state->writeMemory<uint32_t>(pc + idx * 4, opcodes[idx]);
+        }
+        state->writeMemory<uint64_t>(counter_paddr, 0);
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->setPc(pc);
+        }
+
+        atlas_sim_->runHarts_();
+
+        EXPECT_EQUAL(state->readMemory<uint64_t>(counter_paddr), NUM_HARTS * num_iterations);
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas::AtlasState* hart_state = atlas_sim_->getAtlasState(hart_id);
+            EXPECT_EQUAL(hart_state->getSimState()->inst_count, ilimit);
+            EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(hart_state, 28), 0);
+            EXPECT_EQUAL(hart_state->getPc(), pc + (opcodes.size() - 1) * 4);
+        }
+    }
+
+    void testHartException(const uint64_t quantum)
+    {
+        std::cout << "Testing an exception thrown by a hart" << std::endl;
+
+        // Hart 0 loads from outside of memory, which throws. Hart 1 spins.
+        const atlas::Addr pc = 0x1000;
+        const std::vector<uint32_t> opcodes = {
+            0xf14022f3, // csrr x5, mhartid
+            0x00029863, // bne x5, x0, +16
+            0x00100393, // addi x7, x0, 1
+            0x02539393, // slli x7, x7, 37
+            0x0003b083, // ld x1, 0(x7)
+            0x00130313, // addi x6, x6, 1
+            0xffdff06f  // jal x0, -4
+        };
+        atlas::AtlasState* state = atlas_sim_->getAtlasState(0);
+        for (size_t idx = 0; idx < opcodes.size(); ++idx)
+        {
+            state->writeMemory<uint32_t>(pc + idx * 4, opcodes[idx]);
+        }
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->setPc(pc);
+        }
+
+        // The exception is rethrown once every hart has stopped
+        EXPECT_THROW(atlas_sim_->runHarts_());
+
+        // The other harts are stopped at the end of the quantum the exception was thrown in
+        for (uint32_t hart_id = 1; hart_id < NUM_HARTS; ++hart_id)
+        {
+            const atlas::AtlasState::SimState* sim_state =
+                atlas_sim_->getAtlasState(hart_id)->getSimState();
+            EXPECT_TRUE(sim_state->sim_stopped);
+            EXPECT_EQUAL(sim_state->inst_count, quantum);
+            EXPECT_EQUAL(sim_state->workload_exit_code, 1);
+        }
+    }
+
+    void testSoftfloatState()
+    {
+        std::cout << "Testing per-hart floating point state" << std::endl;
+
+        // Hart 0 rounds up and computes 1.0/3.0 (inexact), hart 1 keeps the default rounding
+        // mode and computes 1.0/1.0 (exact) afterwards on the same host thread
+        const atlas::Addr pc = 0x1000;
+        const std::vector<uint32_t> opcodes = {
+            0xf14022f3, // csrr x5, mhartid
+            0x00100313, // addi x6, x0, 1
+            0x00300393, // addi x7, x0, 3
+            0x00029663, // bne x5, x0, +12
+            0x0021d073, // fsrmi x0, 3 (RUP)
+            0x0080006f, // jal x0, +8
+            0x00100393, // addi x7, x0, 1
+            0xd20300d3, // fcvt.d.w f1, x6
+            0xd2038153, // fcvt.d.w f2, x7
+            0x1a20f1d3, // fdiv.d f3, f1, f2 (dynamic rounding mode)
+            0x0000006f  // jal x0, 0
+        };
+        atlas::AtlasState* state = atlas_sim_->getAtlasState(0);
+        for (size_t idx = 0; idx < opcodes.size(); ++idx)
+        {
+            state->writeMemory<uint32_t>(pc + idx * 4, opcodes[idx]);
+        }
+
+        for (uint32_t hart_id = 0; hart_id < NUM_HARTS; ++hart_id)
+        {
+            atlas_sim_->getAtlasState(hart_id)->setPc(pc);
+        }
+
+        // Each hart finishes within its first quantum, hart 0 runs first
+        atlas_sim_->runHarts_();
+
+        atlas::AtlasState* hart0_state = atlas_sim_->getAtlasState(0);
+        EXPECT_EQUAL(atlas::READ_CSR_REG<atlas::RV64>(hart0_state, atlas::FRM), 3);
+        EXPECT_EQUAL(atlas::READ_CSR_REG<atlas::RV64>(hart0_state, atlas::FFLAGS), 0x1);
+        EXPECT_EQUAL(atlas::READ_FP_REG<atlas::RV64>(hart0_state, 3), 0x3fd5555555555556);
+
+        atlas::AtlasState* hart1_state = atlas_sim_->getAtlasState(1);
+        EXPECT_EQUAL(atlas::READ_CSR_REG<atlas::RV64>(hart1_state, atlas::FRM), 0);
+        EXPECT_EQUAL(atlas::READ_CSR_REG<atlas::RV64>(hart1_state, atlas::FFLAGS), 0);
+        EXPECT_EQUAL(atlas::READ_FP_REG<atlas::RV64>(hart1_state, 3), 0x3ff0000000000000);
+    }
+
+  private:
+    static constexpr uint32_t NUM_HARTS = 2;
+
+    uint64_t getHart0Counter_(const std::string & name) const
+    {
+        return atlas_sim_->getRoot()
+            ->getChildAs<sparta::CounterBase>("core0.fetch.stats." + name)
+            ->get();
+    }
+
+    sparta::Scheduler scheduler_;
+    std::unique_ptr<atlas::AtlasSim> atlas_sim_;
+};
+
+int main(int argc, char** argv)
+{
+    const std::string mode = (argc > 1) ? argv[1] : "";
+
+    if ((mode == "inst_limit") || (mode == "parallel_inst_limit"))
+    {
+        // Quanta that do not divide the limit, so the limit is reached in the middle of one
+        const uint64_t ilimit = 1001;
+        const uint64_t quantum = 100;
+        MultiHartTester tester(ilimit, quantum, mode == "parallel_inst_limit");
+        tester.testInstLimit(ilimit);
+    }
+    else if ((mode == "atomic_counter") || (mode == "parallel_atomic_counter"))
+    {
+        // Enough for both harts to finish the loop (3 + 3 * 1000 instructions)
+        const uint64_t ilimit = 3100;
+        const uint64_t quantum = 100;
+        MultiHartTester tester(ilimit, quantum, mode == "parallel_atomic_counter");
+        tester.testAtomicCounter(ilimit, 1000);
+    }
+    else if (mode == "softfloat")
+    {
+        const uint64_t ilimit = 40;
+        const uint64_t quantum = 20;
+        MultiHartTester tester(ilimit, quantum);
+        tester.testSoftfloatState();
+    }
+    else if ((mode == "wfi") || (mode == "parallel_wfi"))
+    {
+        const uint64_t ilimit = 0;
+        const uint64_t quantum = 3;
+        const bool parallel_harts = (mode == "parallel_wfi");
+        const bool stop_sim_on_wfi = true;
+        MultiHartTester tester(ilimit, quantum, parallel_harts, stop_sim_on_wfi);
+        tester.testStopOnWfi();
+    }
+    else if (mode == "fence_i")
+    {
+        MultiHartTester tester;
+        tester.testFenceI();
+    }
+    else if (mode == "lr_sc")
+    {
+        MultiHartTester tester;
+        tester.testLrScReservation();
+    }
+    else if (mode == "parallel_exception")
+    {
+        const uint64_t ilimit = 0;
+        const uint64_t quantum = 100;
+        MultiHartTester tester(ilimit, quantum, true);
+        tester.testHartException(quantum);
+    }
+    else
+    {
+        MultiHartTester tester;
+        tester.testHartIds();
+    }
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
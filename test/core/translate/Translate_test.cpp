@@ -1,12 +1,17 @@
 #include "sim/AtlasSim.hpp"
 
 #include "core/AtlasState.hpp"
+#include "core/Fetch.hpp"
 #include "core/translate/PageTable.hpp"
 
 #include "include/AtlasTypes.hpp"
 #include "include/CSRNums.hpp"
 
 #include <bitset>
+#include <cstring>
+#include <optional>
+#include <vector>
+#include "sparta/statistics/CounterBase.hpp"
 #include "sparta/utils/SpartaTester.hpp"
 
 class AtlasTranslateTester
@@ -25,6 +30,7 @@ class AtlasTranslateTester
 
         state_ = atlas_sim_->getAtlasState();
         translate_unit_ = state_->getTranslateUnit();
+        fetch_unit_ = state_->getFetchUnit();
     }
 
     void testAtlasTranslationStateBasic()
@@ -430,12 +436,462 @@ class AtlasTranslateTester
         translation_state->reset();
     }
 
+    void testSoftTlb()
+    {
+        std::cout << "Testing soft TLB\n" << std::endl;
+
+        using AccessType = atlas::Translate::AccessType;
+        const atlas::Addr vaddr = 0x1234;
+        const atlas::Addr paddr = 0x80001234;
+        const atlas::AtlasTranslationState::TranslationRequest request(vaddr, 8);
+        translate_unit_->fillSoftTlb_<AccessType::LOAD>(state_, request, paddr);
+
+        // Any load in the page hits
+        const atlas::Translate::SoftTlbEntry* entry =
+            translate_unit_->lookupSoftTlb<AccessType::LOAD>(0x1ff8, 8);
+        EXPECT_TRUE(entry != nullptr);
+        EXPECT_EQUAL(entry->vpage, 0x1000);
+        EXPECT_EQUAL(entry->ppage, 0x80001000);
+        EXPECT_TRUE(entry->host_page != nullptr);
+
+        // Stores have their own entries
+        EXPECT_TRUE(translate_unit_->lookupSoftTlb<AccessType::STORE>(vaddr, 8) == nullptr);
+
+        // Accesses that cross the page miss
+        EXPECT_TRUE(translate_unit_->lookupSoftTlb<AccessType::LOAD>(0x1ffc, 8) == nullptr);
+
+        // The host pointer is coherent with memory
+        state_->writeMemory<uint64_t>(paddr, 0x0123456789abcdef);
+        uint64_t value = 0;
+        std::memcpy(&value, entry->host_page + (vaddr & 0xfff), sizeof(value));
+        EXPECT_EQUAL(value, 0x0123456789abcdef);
+
+        translate_unit_->flushSoftTlb();
+        EXPECT_TRUE(translate_unit_->lookupSoftTlb<AccessType::LOAD>(vaddr, 8) == nullptr);
+    }
+
+    void testTlb()
+    {
+        std::cout << "Testing TLB\n" << std::endl;
+
+        atlas::TLB* tlb = translate_unit_->getTLB_<atlas::Translate::AccessType::LOAD>();
+        EXPECT_TRUE(tlb != nullptr);
+        tlb->flush();
+
+        const atlas::MMUMode mode = atlas::MMUMode::SV39;
+        const uint32_t vmid = 0;
+
+        // 4K page in address space 1
+        const bool global = true;
+        tlb->insert(0x5000, mode, 1, vmid, !global, 0xfff, 1, 0x1234, 0x80000000);
+        const atlas::TLB::Entry* entry = tlb->lookup(0x5abc, mode, 1, vmid);
+        EXPECT_TRUE(entry != nullptr);
+        EXPECT_EQUAL(entry->pte, 0x1234);
+        EXPECT_EQUAL(entry->pte_paddr, 0x80000000);
+        EXPECT_TRUE(tlb->lookup(0x5abc, mode, 2, vmid) == nullptr);
+        EXPECT_TRUE(tlb->lookup(0x6000, mode, 1, vmid) == nullptr);
+        EXPECT_TRUE(tlb->lookup(0x5abc, atlas::MMUMode::SV48, 1, vmid) == nullptr);
+
+        // Global 2M page
+        tlb->insert(0x40000000, mode, 1, vmid, global, 0x1fffff, 2, 0x5678, 0x80001000);
+        entry = tlb->lookup(0x401ff000, mode, 7, vmid);
+        EXPECT_TRUE(entry != nullptr);
+        EXPECT_EQUAL(entry->level, 2);
+
+        // Flush by address
+        tlb->flush(0x5000, std::nullopt);
+        EXPECT_TRUE(tlb->lookup(0x5abc, mode, 1, vmid) == nullptr);
+        EXPECT_TRUE(tlb->lookup(0x40000000, mode, 1, vmid) != nullptr);
+
+        // Flushing an address space does not flush global pages
+        tlb->insert(0x5000, mode, 1, vmid, !global, 0xfff, 1, 0x1234, 0x80000000);
+        tlb->flush(std::nullopt, 1);
+        EXPECT_TRUE(tlb->lookup(0x5abc, mode, 1, vmid) == nullptr);
+        EXPECT_TRUE(tlb->lookup(0x40000000, mode, 1, vmid) != nullptr);
+
+        tlb->flush();
+        EXPECT_TRUE(tlb->lookup(0x40000000, mode, 1, vmid) == nullptr);
+    }
+
+    void testPageWalkCache()
+    {
+        std::cout << "Testing page walk cache\n" << std::endl;
+
+        atlas::PageWalkCache* pwc = translate_unit_->page_walk_cache_.get();
+        EXPECT_TRUE(pwc != nullptr);
+        pwc->flush();
+
+        const atlas::MMUMode mode = atlas::MMUMode::SV39;
+        const atlas::Addr root_paddr = 0x80000000;
+
+        // Level 3 PTE covering a 1G region and level 2 PTE covering a 2M region
+        const atlas::Addr vaddr = 0x40201000;
+        pwc->insert(3, vaddr >> 30, mode, root_paddr, 0x80001000);
+        pwc->insert(2, vaddr >> 21, mode, root_paddr, 0x80002000);
+        EXPECT_EQUAL(pwc->lookup(3, vaddr >> 30, mode, root_paddr).value(), 0x80001000);
+        EXPECT_EQUAL(pwc->lookup(2, vaddr >> 21, mode, root_paddr).value(), 0x80002000);
+
+        // Tagged by mode and root page table
+        EXPECT_FALSE(pwc->lookup(2, vaddr >> 21, atlas::MMUMode::SV48, root_paddr));
+        EXPECT_FALSE(pwc->lookup(2, vaddr >> 21, mode, 0x90000000));
+        EXPECT_FALSE(pwc->lookup(2, (vaddr + 0x200000) >> 21, mode, root_paddr));
+
+        // sfence.vma flushes all non-leaf PTEs
+        translate_unit_->flushTlb(vaddr, 1);
+        EXPECT_FALSE(pwc->lookup(3, vaddr >> 30, mode, root_paddr));
+        EXPECT_FALSE(pwc->lookup(2, vaddr >> 21, mode, root_paddr));
+    }
+
+    void testSv39Translation()
+    {
+        std::cout << "Testing Sv39 translation\n" << std::endl;
+
+        using AccessType = atlas::Translate::AccessType;
+        const sparta::Counter & page_walks = translate_unit_->page_walks_;
+        translate_unit_->flushTlb(std::nullopt, std::nullopt);
+        enableSv39_(1);
+
+        // 4K page, the second access hits in the TLB
+        mapSv39Page_(0x50000000, 0x300000, PTE_RX);
+        uint64_t num_walks = page_walks.get();
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50000123).value(), 0x300123);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50000ffc).value(), 0x300ffc);
+        EXPECT_EQUAL(page_walks.get(), num_walks);
+
+        // 2M and 1G superpages, the physical address of a hit is computed from the cached PTE
+        mapSv39Page_(0x50200000, 0x400000, PTE_RX, 2);
+        mapSv39Page_(0x80000000, 0x40000000, PTE_RX, 3);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50212344).value(), 0x412344);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x803ffff0).value(), 0x403ffff0);
+        num_walks += 2;
+        EXPECT_EQUAL(page_walks.get(), num_walks);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x503ffffc).value(), 0x5ffffc);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0xbff01230).value(), 0x7ff01230);
+        EXPECT_EQUAL(page_walks.get(), num_walks);
+
+        // Non-global pages are only cached for their address space, global pages for all of them
+        mapSv39Page_(0x50001000, 0x301000, PTE_RX | PTE_G);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50001000).value(), 0x301000);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+        enableSv39_(2);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50000123).value(), 0x300123);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50001000).value(), 0x301000);
+        EXPECT_EQUAL(page_walks.get(), num_walks);
+        enableSv39_(1);
+
+        // sfence.vma by address flushes the page in every address space
+        translate_unit_->flushTlb(0x50000000, std::nullopt);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50000123).value(), 0x300123);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50212344).value(), 0x412344);
+        EXPECT_EQUAL(page_walks.get(), num_walks);
+
+        // sfence.vma by address space keeps the global pages
+        translate_unit_->flushTlb(std::nullopt, 1);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50001000).value(), 0x301000);
+        EXPECT_EQUAL(page_walks.get(), num_walks);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50000123).value(), 0x300123);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+
+        // sfence.vma without arguments flushes everything
+        translate_unit_->flushTlb(std::nullopt, std::nullopt);
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(0x50001000).value(), 0x301000);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+
+        // A fetch from a page without execute permission faults
+        mapSv39Page_(0x50003000, 0x303000, PTE_RW);
+        EXPECT_FALSE(translateSv39_<AccessType::INSTRUCTION>(0x50003000).has_value());
+
+        disableTranslation_();
+    }
+
+    void testSv39AccessedDirty()
+    {
+        std::cout << "Testing Sv39 A/D bit updates\n" << std::endl;
+
+        using AccessType = atlas::Translate::AccessType;
+        const sparta::Counter & page_walks = translate_unit_->page_walks_;
+        atlas::POKE_CSR_FIELD<atlas::RV64, atlas::CSR_FIELDS::MENVCFG::adue>(state_, 1);
+        enableSv39_();
+
+        const uint64_t LD_OPCODE = 0x00013083; // ld x1, 0(x2)
+        state_->setCurrentInst(state_->getMavis()->makeInst(LD_OPCODE, state_));
+
+        // A load sets the accessed bit and caches the PTE without the dirty bit
+        const atlas::Addr vaddr = 0x50004000;
+        const atlas::Addr pte_paddr = mapSv39Page_(vaddr, 0x304000, PTE_R | PTE_W);
+        uint64_t num_walks = page_walks.get();
+        EXPECT_EQUAL(translateSv39_<AccessType::LOAD>(vaddr + 8).value(), 0x304008);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+        EXPECT_EQUAL(state_->readMemory<uint64_t>(pte_paddr),
+                     makeSv39Pte_(0x304000, PTE_R | PTE_W | PTE_A));
+
+        // A store that hits has to set the dirty bit, it walks the page table again instead of
+        // writing back the cached PTE. The PTE was changed without an sfence.vma.
+        state_->writeMemory<uint64_t>(pte_paddr, makeSv39Pte_(0x305000, PTE_R | PTE_W | PTE_A));
+        EXPECT_EQUAL(translateSv39_<AccessType::STORE>(vaddr + 8).value(), 0x305008);
+        EXPECT_EQUAL(page_walks.get(), ++num_walks);
+        EXPECT_EQUAL(state_->readMemory<uint64_t>(pte_paddr), makeSv39Pte_(0x305000, PTE_RW));
+
+        // Once dirty, stores hit
+        EXPECT_EQUAL(translateSv39_<AccessType::STORE>(vaddr + 16).value(), 0x305010);
+        EXPECT_EQUAL(page_walks.get(), num_walks);
+
+        // Without hardware A/D updates, accessing a page that is not dirty faults
+        atlas::POKE_CSR_FIELD<atlas::RV64, atlas::CSR_FIELDS::MENVCFG::adue>(state_, 0);
+        state_->changeMMUMode<atlas::RV64>();
+        mapSv39Page_(vaddr + 0x1000, 0x306000, PTE_R | PTE_W | PTE_A);
+        EXPECT_EQUAL(translateSv39_<AccessType::LOAD>(vaddr + 0x1000).value(), 0x306000);
+        EXPECT_FALSE(translateSv39_<AccessType::STORE>(vaddr + 0x1000).has_value());
+
+        state_->setCurrentInst(nullptr);
+        disableTranslation_();
+    }
+
+    void testSv39Permissions()
+    {
+        std::cout << "Testing Sv39 SUM and MXR\n" << std::endl;
+
+        using AccessType = atlas::Translate::AccessType;
+        using MSTATUS = atlas::CSR_FIELDS::MSTATUS;
+        enableSv39_();
+
+        const uint64_t LD_OPCODE = 0x00013083; // ld x1, 0(x2)
+        state_->setCurrentInst(state_->getMavis()->makeInst(LD_OPCODE, state_));
+
+        const atlas::Addr user_data_vaddr = 0x50010000;
+        const atlas::Addr user_code_vaddr = 0x50011000;
+        const atlas::Addr super_data_vaddr = 0x50012000;
+        const atlas::Addr exec_only_vaddr = 0x50013000;
+        mapSv39Page_(user_data_vaddr, 0x310000, PTE_RW | PTE_U);
+        mapSv39Page_(user_code_vaddr, 0x311000, PTE_RX | PTE_U);
+        mapSv39Page_(super_data_vaddr, 0x312000, PTE_RW);
+        mapSv39Page_(exec_only_vaddr, 0x313000, PTE_X | PTE_A);
+
+        // Supervisor mode can only load from User mode pages if SUM is set
+        EXPECT_FALSE(translateSv39_<AccessType::LOAD>(user_data_vaddr).has_value());
+        atlas::WRITE_CSR_FIELD<atlas::RV64, MSTATUS::sum>(state_, 1);
+        state_->changeMMUMode<atlas::RV64>();
+        EXPECT_EQUAL(translateSv39_<AccessType::LOAD>(user_data_vaddr).value(), 0x310000);
+        EXPECT_EQUAL(translateSv39_<AccessType::STORE>(user_data_vaddr).value(), 0x310000);
+
+        // ... and can never fetch from them
+        EXPECT_FALSE(translateSv39_<AccessType::INSTRUCTION>(user_code_vaddr).has_value());
+
+        // Loads from execute-only pages need MXR
+        EXPECT_FALSE(translateSv39_<AccessType::LOAD>(exec_only_vaddr).has_value());
+        atlas::WRITE_CSR_FIELD<atlas::RV64, MSTATUS::mxr>(state_, 1);
+        state_->changeMMUMode<atlas::RV64>();
+        EXPECT_EQUAL(translateSv39_<AccessType::LOAD>(exec_only_vaddr).value(), 0x313000);
+        EXPECT_FALSE(translateSv39_<AccessType::STORE>(exec_only_vaddr).has_value());
+
+        // User mode can only access User mode pages
+        state_->setPrivMode(atlas::PrivMode::USER, false);
+        state_->changeMMUMode<atlas::RV64>();
+        EXPECT_EQUAL(translateSv39_<AccessType::INSTRUCTION>(user_code_vaddr).value(), 0x311000);
+        EXPECT_EQUAL(translateSv39_<AccessType::LOAD>(user_data_vaddr).value(), 0x310000);
+        EXPECT_FALSE(translateSv39_<AccessType::LOAD>(super_data_vaddr).has_value());
+
+#ifndef NDEBUG
+        // Translating with a context that was not updated after a change is caught
+        atlas::WRITE_CSR_FIELD<atlas::RV64, MSTATUS::sum>(state_, 0);
+        EXPECT_THROW(translateSv39_<AccessType::LOAD>(user_data_vaddr));
+        state_->getCurrentInst()->getTranslationState()->reset();
+#endif
+
+        atlas::WRITE_CSR_FIELD<atlas::RV64, MSTATUS::sum>(state_, 0);
+        atlas::WRITE_CSR_FIELD<atlas::RV64, MSTATUS::mxr>(state_, 0);
+        state_->setCurrentInst(nullptr);
+        disableTranslation_();
+    }
+
+    void testDecodeCacheRemap()
+    {
+        std::cout << "Testing decode cache after remapping a code page\n" << std::endl;
+
+        // Loop on two pages: addi x5, x5, 1/2; jal x0, +0xffc; sfence.vma; jal x0, -0x1004
+        const atlas::Addr code_vaddr = 0x40000000;
+        const atlas::Addr addi1_paddr = 0x200000;
+        const atlas::Addr addi2_paddr = 0x201000;
+        const atlas::Addr sfence_paddr = 0x202000;
+        const uint32_t ADDI_X5_X5_1 = 0x00128293;
+        const uint32_t ADDI_X5_X5_2 = 0x00228293;
+        const uint32_t JAL_X0_FWD = 0x7fd0006f;
+        const uint32_t SFENCE_VMA = 0x12000073;
+        const uint32_t JAL_X0_BACK = 0xffdfe06f;
+        state_->writeMemory<uint32_t>(addi1_paddr, ADDI_X5_X5_1);
+        state_->writeMemory<uint32_t>(addi1_paddr + 4, JAL_X0_FWD);
+        state_->writeMemory<uint32_t>(addi2_paddr, ADDI_X5_X5_2);
+        state_->writeMemory<uint32_t>(addi2_paddr + 4, JAL_X0_FWD);
+        state_->writeMemory<uint32_t>(sfence_paddr, SFENCE_VMA);
+        state_->writeMemory<uint32_t>(sfence_paddr + 4, JAL_X0_BACK);
+
+        const atlas::Addr addi_pte_paddr = mapSv39Page_(code_vaddr, addi1_paddr, PTE_RX);
+        mapSv39Page_(code_vaddr + 0x1000, sfence_paddr, PTE_RX);
+        enableSv39_();
+
+        atlas::WRITE_INT_REG<atlas::RV64>(state_, 5, 0);
+        state_->setPc(code_vaddr);
+        fetch_unit_->runQuantum(40);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 10);
+        EXPECT_EQUAL(state_->getPc(), code_vaddr);
+
+        // Same virtual PC, different physical page. The sfence.vma in the loop makes the new
+        // mapping visible and the addi on the new page must be decoded.
+        state_->writeMemory<uint64_t>(addi_pte_paddr, makeSv39Pte_(addi2_paddr, PTE_RX));
+        fetch_unit_->runQuantum(40);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 30);
+        EXPECT_EQUAL(state_->getPc(), code_vaddr);
+
+        disableTranslation_();
+    }
+
+    void testSfenceBlockInvalidation()
+    {
+        std::cout << "Testing basic block invalidation by sfence.vma\n" << std::endl;
+
+        // Loop: addi x5, x5, 1; jal x0, -4
+        const atlas::Addr code_vaddr = 0x40002000;
+        const atlas::Addr code_paddr = 0x203000;
+        state_->writeMemory<uint32_t>(code_paddr, 0x00128293);
+        state_->writeMemory<uint32_t>(code_paddr + 4, 0xffdff06f);
+        mapSv39Page_(code_vaddr, code_paddr, PTE_RX);
+        const uint32_t asid = 1;
+        enableSv39_(asid);
+
+        atlas::WRITE_INT_REG<atlas::RV64>(state_, 5, 0);
+        state_->setPc(code_vaddr);
+        fetch_unit_->runQuantum(40);
+        const uint64_t blocks_created = getFetchCounter_("basic_blocks_created");
+        const uint64_t blocks_invalidated = getFetchCounter_("translated_block_invalidations");
+        EXPECT_TRUE(blocks_created > 0);
+
+        // Flushes of other superpages and other address spaces keep the block
+        fetch_unit_->invalidateTranslatedBlocks(0x80000000, std::nullopt);
+        fetch_unit_->invalidateTranslatedBlocks(std::nullopt, asid + 1);
+        fetch_unit_->runQuantum(40);
+        EXPECT_EQUAL(getFetchCounter_("translated_block_invalidations"), blocks_invalidated);
+        EXPECT_EQUAL(getFetchCounter_("basic_blocks_created"), blocks_created);
+
+        // Flushing the code page invalidates the block and it is recorded again
+        fetch_unit_->invalidateTranslatedBlocks(code_vaddr, asid);
+        fetch_unit_->runQuantum(40);
+        EXPECT_EQUAL(getFetchCounter_("translated_block_invalidations"), blocks_invalidated + 1);
+        EXPECT_EQUAL(getFetchCounter_("basic_blocks_created"), blocks_created + 1);
+        EXPECT_EQUAL(atlas::READ_INT_REG<atlas::RV64>(state_, 5), 60);
+
+        disableTranslation_();
+    }
+
   private:
+    // Translate an access with the Sv39 translate Action, returns nullopt on a page fault. Loads
+    // and stores are translated for the current instruction.
+    template <atlas::Translate::AccessType TYPE>
+    std::optional<atlas::Addr> translateSv39_(const atlas::Addr vaddr)
+    {
+        atlas::AtlasTranslationState* translation_state =
+            (TYPE == atlas::Translate::AccessType::INSTRUCTION)
+                ? state_->getFetchTranslationState()
+                : state_->getCurrentInst()->getTranslationState();
+        translation_state->makeRequest(vaddr, 4);
+
+        std::vector<atlas::Action> actions(1);
+        translate_unit_->translate_<atlas::RV64, atlas::MMUMode::SV39, TYPE>(state_,
+                                                                            actions.begin());
+
+        // Page faults redirect execution to the Exception unit
+        std::optional<atlas::Addr> paddr;
+        if (state_->takeActionGroupRedirect() == nullptr)
+        {
+            paddr = translation_state->getResult().getPAddr();
+        }
+        translation_state->reset();
+        return paddr;
+    }
+
+    uint64_t getFetchCounter_(const std::string & name) const
+    {
+        return atlas_sim_->getRoot()
+            ->getChildAs<sparta::CounterBase>("core0.fetch.stats." + name)
+            ->get();
+    }
+
+    // Sv39 PTE bits
+    static constexpr uint64_t PTE_V = 0x1;
+    static constexpr uint64_t PTE_R = 0x2;
+    static constexpr uint64_t PTE_W = 0x4;
+    static constexpr uint64_t PTE_X = 0x8;
+    static constexpr uint64_t PTE_U = 0x10;
+    static constexpr uint64_t PTE_G = 0x20;
+    static constexpr uint64_t PTE_A = 0x40;
+    static constexpr uint64_t PTE_D = 0x80;
+    static constexpr uint64_t PTE_RX = PTE_R | PTE_X | PTE_A;
+    static constexpr uint64_t PTE_RW = PTE_R | PTE_W | PTE_A | PTE_D;
+
+    // Sv39 page tables are allocated from here, the first one is the root
+    static constexpr atlas::Addr SV39_ROOT_PADDR = 0x100000;
+    atlas::Addr next_page_table_paddr_ = SV39_ROOT_PADDR + 0x1000;
+
+    static uint64_t makeSv39Pte_(const atlas::Addr paddr, const uint64_t flags)
+    {
+        return ((paddr >> 12) << 10) | flags | PTE_V;
+    }
+
+    // Map vaddr to paddr with a leaf PTE at the given level (1 for a 4K page, 2 for a 2M page
+    // and 3 for a 1G page), allocating the non-leaf page tables as needed. Returns the address
+    // of the leaf PTE.
+    atlas::Addr mapSv39Page_(const atlas::Addr vaddr, const atlas::Addr paddr,
+                             const uint64_t flags, const uint32_t level = 1)
+    {
+        atlas::Addr table_paddr = SV39_ROOT_PADDR;
+        for (uint32_t table_level = 3; table_level > level; --table_level)
+        {
+            const uint32_t shift = 12 + 9 * (table_level - 1);
+            const atlas::Addr pte_paddr = table_paddr + ((vaddr >> shift) & 0x1ff) * 8;
+            uint64_t pte = state_->readMemory<uint64_t>(pte_paddr);
+            if ((pte & PTE_V) == 0)
+            {
+                pte = makeSv39Pte_(next_page_table_paddr_, 0);
+                next_page_table_paddr_ += 0x1000;
+                state_->writeMemory<uint64_t>(pte_paddr, pte);
+            }
+            table_paddr = (pte >> 10) << 12;
+        }
+
+        const uint32_t shift = 12 + 9 * (level - 1);
+        const atlas::Addr pte_paddr = table_paddr + ((vaddr >> shift) & 0x1ff) * 8;
+        state_->writeMemory<uint64_t>(pte_paddr, makeSv39Pte_(paddr, flags));
+        return pte_paddr;
+    }
+
+    // Enter S-mode with Sv39 translation
+    void enableSv39_(const uint64_t asid = 0)
+    {
+        const uint64_t satp = (8ull << 60) | (asid << 44) | (SV39_ROOT_PADDR >> 12);
+        atlas::POKE_CSR_REG<atlas::RV64>(state_, atlas::SATP, satp);
+        state_->setPrivMode(atlas::PrivMode::SUPERVISOR, false);
+        state_->changeMMUMode<atlas::RV64>();
+    }
+
+    // Back to M-mode without translation, with every cached translation flushed
+    void disableTranslation_()
+    {
+        atlas::POKE_CSR_REG<atlas::RV64>(state_, atlas::SATP, 0);
+        state_->setPrivMode(atlas::PrivMode::MACHINE, false);
+        state_->changeMMUMode<atlas::RV64>();
+        translate_unit_->flushTlb(std::nullopt, std::nullopt);
+        translate_unit_->flushSoftTlb();
+        fetch_unit_->invalidateBlockCache();
+    }
+
     sparta::Scheduler scheduler_;
     std::unique_ptr<atlas::AtlasSim> atlas_sim_;
 
     atlas::AtlasState* state_ = nullptr;
     atlas::Translate* translate_unit_ = nullptr;
+    atlas::Fetch* fetch_unit_ = nullptr;
 };
 
 int main(int argc, char** argv)
@@ -448,6 +904,14 @@ int main(int argc, char** argv)
     translate_tester.testAtlasTranslationStateBasic();
     translate_tester.testAtlasTranslationStateMisaligned();
     translate_tester.testAtlasTranslationStateMultiple();
+    translate_tester.testSoftTlb();
+    translate_tester.testTlb();
+    translate_tester.testPageWalkCache();
+    translate_tester.testSv39Translation();
+    translate_tester.testSv39AccessedDirty();
+    translate_tester.testSv39Permissions();
+    translate_tester.testDecodeCacheRemap();
+    translate_tester.testSfenceBlockInvalidation();
     // translate_tester.testPageTableEntry();
     // translate_tester.testPageTable();
 
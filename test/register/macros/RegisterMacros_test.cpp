@@ -274,6 +274,13 @@ void testCsrRegs()
 
     EXPECT_EQUAL(READ_CSR_FIELD<atlas::RV64>(state, atlas::MVENDORID, "Bank"), 0xe);
     EXPECT_EQUAL(READ_CSR_FIELD<atlas::RV64>(state, atlas::MVENDORID, "Offset"), 0xf);
+
+    // Case 7: Compile-time field descriptors match the string lookups
+    POKE_CSR_REG<atlas::RV64>(state, atlas::SSTATUS, 0);
+    WRITE_CSR_FIELD<atlas::RV64, atlas::CSR_FIELDS::SSTATUS::xs>(state, 3);
+    EXPECT_EQUAL(READ_CSR_FIELD<atlas::RV64>(state, atlas::SSTATUS, "XS"), 3);
+    EXPECT_EQUAL((READ_CSR_FIELD<atlas::RV64, atlas::CSR_FIELDS::SSTATUS::xs>(state)), 3);
+    EXPECT_EQUAL((READ_CSR_FIELD<atlas::RV64, atlas::CSR_FIELDS::MVENDORID::bank>(state)), 0xe);
 }
 
 int main()
@@ -38,6 +38,52 @@ class VlsInstructionTester : public AtlasInstructionTester
         EXPECT_EQUAL(sim_state->inst_count, 1);
     }
 
+    void testVle8PageCrossing()
+    {
+        atlas::AtlasState* state = getAtlasState();
+        const uint64_t pc = 0x1000;
+        const atlas::Addr addr = 0x2ffc; // 4 bytes in each page
+        const uint64_t v1_val = 0x1817161514131211;
+        const uint32_t vd = 1, rs1 = 1;
+
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(8); // avl = 8
+        state->writeMemory<uint32_t>(addr, v1_val);
+        state->writeMemory<uint32_t>(addr + 4, v1_val >> 32);
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+
+        uint32_t opcode = vle8Op(vd, rs1, 1); // vm = 1 unmasked
+        injectInstruction(pc, opcode);
+
+        auto vd_val = READ_VEC_REG<VLEN>(state, vd);
+        for (size_t i = 0; i < vd_val.size(); ++i)
+        {
+            EXPECT_EQUAL(vd_val[i], reinterpret_cast<const uint8_t*>(&v1_val)[i]);
+        }
+    }
+
+    void testVse8()
+    {
+        atlas::AtlasState* state = getAtlasState();
+        const uint64_t pc = 0x1000;
+        const atlas::Addr addr = 0x3ffa; // crosses a page
+        const VLEN vs3_val = {0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28};
+        const uint32_t vs3 = 2, rs1 = 1;
+
+        state->getVectorConfig()->setVSTART(0);
+        state->getVectorConfig()->setVL(8); // avl = 8
+        WRITE_VEC_REG<VLEN>(state, vs3, vs3_val);
+        WRITE_INT_REG<XLEN>(state, rs1, addr);
+
+        uint32_t opcode = vse8Op(vs3, rs1, 1); // vm = 1 unmasked
+        injectInstruction(pc, opcode);
+
+        for (size_t i = 0; i < vs3_val.size(); ++i)
+        {
+            EXPECT_EQUAL(state->readMemory<uint8_t>(addr + i), vs3_val[i]);
+        }
+    }
+
     void testVlse8()
     {
         atlas::AtlasState* state = getAtlasState();
@@ -131,6 +177,12 @@ class VlsInstructionTester : public AtlasInstructionTester
         return opcode;
     }
 
+    uint32_t vse8Op(uint8_t rs3, uint8_t rs1, uint8_t vm)
+    {
+        // Same encoding as vle8 with the store opcode
+        return vle8Op(rs3, rs1, vm) | 0x20;
+    }
+
     uint32_t vlse8Op(uint8_t rd, uint8_t rs1, uint8_t rs2, uint8_t vm)
     {
         uint32_t opcode = 0;
@@ -190,6 +242,8 @@ int main()
     Vls_tester.testVle8();
     Vls_tester.testVlse8();
     Vls_tester.testVloxei8();
+    Vls_tester.testVle8PageCrossing();
+    Vls_tester.testVse8();
 
     REPORT_ERROR;
     return ERROR_CODE;
@@ -2,11 +2,49 @@
 
 #include "sparta/utils/SpartaTester.hpp"
 
+void testByteVector()
+{
+    {
+        atlas::ByteVector byte_vector;
+        EXPECT_EQUAL(byte_vector.size(), 0);
+        EXPECT_TRUE(byte_vector.empty());
+
+        byte_vector.resize(4, 0xaa);
+        EXPECT_EQUAL(byte_vector.size(), 4);
+        EXPECT_EQUAL(byte_vector[3], 0xaa);
+
+        // Shrinking and growing again fills the new bytes
+        byte_vector.resize(2);
+        byte_vector.resize(3);
+        EXPECT_EQUAL(byte_vector[1], 0xaa);
+        EXPECT_EQUAL(byte_vector[2], 0x0);
+
+        byte_vector.push_back(0x55);
+        EXPECT_EQUAL(byte_vector.size(), 4);
+        EXPECT_EQUAL(byte_vector[3], 0x55);
+
+        const atlas::ByteVector copy = byte_vector;
+        EXPECT_TRUE(copy == byte_vector);
+        byte_vector[0] = 0x11;
+        EXPECT_TRUE(copy != byte_vector);
+
+        byte_vector.clear();
+        EXPECT_TRUE(byte_vector.empty());
+    }
+    {
+        // Large enough for a VLEN=2048 vector register
+        atlas::ByteVector byte_vector(atlas::ByteVector::CAPACITY, 0xff);
+        EXPECT_EQUAL(byte_vector.size(), 256);
+        EXPECT_THROW(byte_vector.push_back(0x0));
+        EXPECT_THROW(byte_vector.resize(atlas::ByteVector::CAPACITY + 1));
+    }
+}
+
 void testConvertToByteVector()
 {
     {
         const uint64_t value = 0xdeadbeef;
-        std::vector<uint8_t> byte_vector = atlas::convertToByteVector<uint64_t>(value);
+        atlas::ByteVector byte_vector = atlas::convertToByteVector<uint64_t>(value);
         EXPECT_EQUAL(byte_vector.size(), 8);
         EXPECT_EQUAL(byte_vector[0], 0xef);
         EXPECT_EQUAL(byte_vector[1], 0xbe);
@@ -19,7 +57,7 @@ void testConvertToByteVector()
     }
     {
         const uint32_t value = 0x12345678;
-        std::vector<uint8_t> byte_vector = atlas::convertToByteVector<uint32_t>(value);
+        atlas::ByteVector byte_vector = atlas::convertToByteVector<uint32_t>(value);
         EXPECT_EQUAL(byte_vector.size(), 4);
         EXPECT_EQUAL(byte_vector[0], 0x78);
         EXPECT_EQUAL(byte_vector[1], 0x56);
@@ -28,14 +66,14 @@ void testConvertToByteVector()
     }
     {
         const uint16_t value = 0xabcd;
-        std::vector<uint8_t> byte_vector = atlas::convertToByteVector<uint16_t>(value);
+        atlas::ByteVector byte_vector = atlas::convertToByteVector<uint16_t>(value);
         EXPECT_EQUAL(byte_vector.size(), 2);
         EXPECT_EQUAL(byte_vector[0], 0xcd);
         EXPECT_EQUAL(byte_vector[1], 0xab);
     }
     {
         const uint8_t value = 0xff;
-        std::vector<uint8_t> byte_vector = atlas::convertToByteVector<uint8_t>(value);
+        atlas::ByteVector byte_vector = atlas::convertToByteVector<uint8_t>(value);
         EXPECT_EQUAL(byte_vector.size(), 1);
         EXPECT_EQUAL(byte_vector[0], 0xff);
     }
@@ -44,33 +82,34 @@ void testConvertToByteVector()
 void testConvertFromByteVector()
 {
     {
-        const std::vector<uint8_t> byte_vector{0xef, 0xbe, 0xad, 0xde, 0x0, 0x0, 0x0, 0x0};
+        const atlas::ByteVector byte_vector{0xef, 0xbe, 0xad, 0xde, 0x0, 0x0, 0x0, 0x0};
         const uint64_t value = atlas::convertFromByteVector<uint64_t>(byte_vector);
         EXPECT_EQUAL(value, 0xdeadbeef);
     }
     {
-        const std::vector<uint8_t> byte_vector{0x78, 0x56, 0x34, 0x12};
+        const atlas::ByteVector byte_vector{0x78, 0x56, 0x34, 0x12};
         const uint32_t value = atlas::convertFromByteVector<uint32_t>(byte_vector);
         EXPECT_EQUAL(value, 0x12345678);
     }
     {
-        const std::vector<uint8_t> byte_vector{0xcd, 0xab};
+        const atlas::ByteVector byte_vector{0xcd, 0xab};
         const uint16_t value = atlas::convertFromByteVector<uint16_t>(byte_vector);
         EXPECT_EQUAL(value, 0xabcd);
     }
     {
-        const std::vector<uint8_t> byte_vector{0xff};
+        const atlas::ByteVector byte_vector{0xff};
         const uint8_t value = atlas::convertFromByteVector<uint8_t>(byte_vector);
         EXPECT_EQUAL(value, 0xff);
     }
     {
-        const std::vector<uint8_t> byte_vector{0xff};
+        const atlas::ByteVector byte_vector{0xff};
         EXPECT_THROW(atlas::convertFromByteVector<uint64_t>(byte_vector));
     }
 }
 
 int main()
 {
+    testByteVector();
     testConvertToByteVector();
     testConvertFromByteVector();
 
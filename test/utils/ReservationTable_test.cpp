@@ -0,0 +1,101 @@
+#include "system/ReservationTable.hpp"
+
+#include "sparta/utils/SpartaTester.hpp"
+
+void testReserve()
+{
+    atlas::ReservationTable table;
+    EXPECT_FALSE(table.isAnyReservationActive());
+
+    table.reserve(0, 0x1000);
+    EXPECT_TRUE(table.isAnyReservationActive());
+    EXPECT_TRUE(table.isReserved(0, 0x1000));
+
+    // The whole 64 byte block is reserved
+    EXPECT_TRUE(table.isReserved(0, 0x1038));
+    EXPECT_FALSE(table.isReserved(0, 0x1040));
+    EXPECT_FALSE(table.isReserved(1, 0x1000));
+
+    // A new reservation replaces the old one
+    table.reserve(0, 0x2000);
+    EXPECT_FALSE(table.isReserved(0, 0x1000));
+    EXPECT_TRUE(table.isReserved(0, 0x2000));
+
+    table.clear(0);
+    EXPECT_FALSE(table.isReserved(0, 0x2000));
+    EXPECT_FALSE(table.isAnyReservationActive());
+
+    EXPECT_THROW(table.reserve(atlas::ReservationTable::MAX_HARTS, 0x1000));
+}
+
+void testSnoopStore()
+{
+    atlas::ReservationTable table;
+    table.reserve(0, 0x1000);
+    table.reserve(1, 0x1000);
+    table.reserve(2, 0x1040);
+
+    // Stores by the hart holding the reservation do not clear it
+    table.snoopStore(0, 0x1000, 8);
+    EXPECT_TRUE(table.isReserved(0, 0x1000));
+    EXPECT_FALSE(table.isReserved(1, 0x1000));
+    EXPECT_TRUE(table.isReserved(2, 0x1040));
+
+    // Store crossing into the next block
+    table.snoopStore(3, 0x103c, 8);
+    EXPECT_FALSE(table.isReserved(0, 0x1000));
+    EXPECT_FALSE(table.isReserved(2, 0x1040));
+    EXPECT_FALSE(table.isAnyReservationActive());
+
+    // Different blocks in the same bucket
+    table.reserve(0, 0x0);
+    table.snoopStore(1, 0x4000, 8);
+    EXPECT_TRUE(table.isReserved(0, 0x0));
+    table.snoopStore(1, 0x0, 1);
+    EXPECT_FALSE(table.isReserved(0, 0x0));
+
+    // Clearing a reservation that was cleared by a store
+    table.clear(0);
+    EXPECT_FALSE(table.isAnyReservationActive());
+}
+
+void testStoreConditional()
+{
+    atlas::ReservationTable table;
+    uint64_t mem = 0;
+
+    // SC stores and clears the other harts' reservations on the stored bytes, the store done by
+    // the SC snoops the table while it is locked
+    table.reserve(0, 0x1000);
+    table.reserve(1, 0x1000);
+    EXPECT_TRUE(table.storeConditional(0, 0x1000, 8, [&table, &mem]() {
+        mem = 1;
+        table.snoopStore(0, 0x1000, 8);
+    }));
+    EXPECT_EQUAL(mem, 1);
+    EXPECT_FALSE(table.isReserved(0, 0x1000));
+    EXPECT_FALSE(table.isReserved(1, 0x1000));
+    EXPECT_FALSE(table.isAnyReservationActive());
+
+    // A store by another hart breaks the reservation even if it stores the value loaded by LR
+    table.reserve(0, 0x1000);
+    table.snoopStore(1, 0x1008, 4);
+    EXPECT_FALSE(table.storeConditional(0, 0x1000, 8, [&mem]() { mem = 2; }));
+    EXPECT_EQUAL(mem, 1);
+
+    // SC to a different reservation set fails and drops the reservation
+    table.reserve(0, 0x1000);
+    EXPECT_FALSE(table.storeConditional(0, 0x1040, 8, [&mem]() { mem = 3; }));
+    EXPECT_EQUAL(mem, 1);
+    EXPECT_FALSE(table.isAnyReservationActive());
+}
+
+int main()
+{
+    testReserve();
+    testSnoopStore();
+    testStoreConditional();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}